@@ -63,6 +63,7 @@
 #include <list>
 #include <deque>
 #include <unordered_map>
+#include <algorithm>
 #include <sys/time.h>
 #include <stdarg.h>
 
@@ -70,7 +71,7 @@ using namespace std;
 
 // definition of prefix for bitvector type names
 #define ESOLVER_BITVEC_PREFIX ((string)"BV")
-#define ESOLVER_MAX_BV_SIZE (64)
+#define ESOLVER_MAX_BV_SIZE (4096)
 
 #include "PrimitiveTypeDefs.hpp"
 
@@ -67,16 +67,14 @@ namespace ESolver {
     // Values
     class ConcreteValueBase;
     class ValueManager;
-    class Signature;
+    class StringStore;
+    class WideBVStore;
+    class SignatureStore;
     class ConstManager;
 
     class ConcreteValueBasePtrHasher;
     class ConcreteValueBasePtrEquals;
 
-    class SignaturePtrEquals;
-    class SignaturePtrDeepEquals;
-    class SignaturePtrHasher;
-
     // Contexts and scoping
     class ESContext;
     class ESolverScope;
@@ -97,6 +95,7 @@ namespace ESolver {
     class ESIntType;
     class ESBoolType;
     class ESRealType;
+    class ESStringType;
     class ESSubrangeType;
     class ESEnumType;
     class ESBVTypeTemplate;
@@ -126,13 +125,18 @@ namespace ESolver {
     class InterpretedFuncOperator;
     class SynthFuncOperator;
     class MacroOperator;
+    struct RewriteFacts;
 
     // Loggers
     class Logger;
+    class MemoryBreakdown;
 
     // UID Generators
     class UIDGenerator;
 
+    // Allocators
+    class BumpArena;
+
     // Expressions
     class UserExpressionBase;
     class UserVarExpressionBase;
@@ -156,6 +160,7 @@ namespace ESolver {
     class GenFPExpression;
     class GenLetVarExpression;
     class GenConstExpression;
+    class GenConstHoleExpression;
     class GenLetExpression;
     class GenFuncExpression;
 
@@ -200,6 +205,7 @@ namespace ESolver {
     class ESolverLogic;
     class BVLogic;
     class LIALogic;
+    class StringLogic;
 
     // Evaluation
     class EvalRule;
@@ -209,18 +215,12 @@ namespace ESolver {
     typedef map<string, const ConcreteValueBase*> SMTConcreteValueModel;
 
 
-    template<typename T> class TLVec;
-
     // Typedefs for smart ptrs, etc.
     typedef unordered_set<Expression, ExpressionHasher, ExpressionEquals> ExpressionSet;
 
     typedef unordered_set<const ConcreteValueBase*, ConcreteValueBasePtrHasher,
                           ConcreteValueBasePtrEquals> ConcreteValueSet;
 
-    typedef TLVec<const GenExpressionBase> GenExpTLVec;
-
-    typedef unordered_set<Signature*, SignaturePtrHasher, SignaturePtrDeepEquals> SigSetType;
-
     // Grammar Related classes
     class Grammar;
     class GrammarNode;
@@ -229,6 +229,7 @@ namespace ESolver {
     class GrammarFPVar;
     class GrammarLetVar;
     class GrammarConst;
+    class GrammarConstHole;
     class GrammarExpansion;
 
     // Grammar enumerators
@@ -245,6 +246,11 @@ namespace ESolver {
     // Variable map
     typedef ConcreteValueBase const* const* VariableMap;
     typedef ConcreteValueBase const* const* EvalMap;
+    typedef int64 const* const* BatchEvalMap;
+    // Booleans over all lanes, 64 lanes per word, lane l is bit l % 64
+    typedef uint64 const* const* PackedEvalMap;
+    // Bitvectors wider than 64 bits, least significant limb first
+    typedef vector<uint64> WideBVLimbs;
     typedef ConcreteValueBase const* const* LetBindingMap;
     typedef const uint32* ParameterMap;
     typedef const uint32* SubstMap;
@@ -266,6 +272,12 @@ namespace ESolver {
     // from everything else. Because we simply do not
     // know what kind of bindings it will be used with
     extern bool PartialExpression;
+    // Indicates that integer arithmetic overflowed during
+    // concrete evaluation. The value computed is wrapped
+    // around, so it need not agree with the unbounded
+    // integers of the theory. Such results cannot decide
+    // anything concretely and are left to the theorem prover
+    extern bool ConcreteOverflow;
 
     extern bool TimeOut;
     extern bool MemOut;
@@ -60,12 +60,16 @@ namespace ESolver {
         uint64 CPULimit;
         uint32 RandomSeed;
         bool NoDist;
+        // Use the points and an SMT check to simplify solutions
+        bool PruneSolutions;
+        // Where to write the memory breakdown as JSON, if anywhere
+        string StatsFileName;
 
         // Constructor
         ESolverOpts()
             : StatsLevel(0), CostBudget(DEFAULT_COST_BUDGET), LogFileName(""),
               MemoryLimit(MEM_LIMIT_INFINITE), CPULimit(CPU_LIMIT_INFINITE), 
-              RandomSeed(0), NoDist(false)
+              RandomSeed(0), NoDist(false), PruneSolutions(false), StatsFileName("")
         {
             // Nothing here
         }
@@ -0,0 +1,148 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// A bump allocator for objects that are freed all at once
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "../common/ESolverForwardDecls.hpp"
+#include "../exceptions/ESException.hpp"
+#include <cstdlib>
+
+#if defined ESOLVER_HUGE_PAGE_ARENAS
+#include <sys/mman.h>
+#endif
+
+// Arenas backed by huge pages map regions of at least this size
+#define ESOLVER_HUGE_PAGE_REGION_SIZE ((uint64)1 << 25)
+#define ESOLVER_HUGE_PAGE_SIZE ((uint64)1 << 21)
+
+namespace ESolver {
+
+    // Objects of different sizes are carved out of large chunks, one
+    // after the other, so that objects allocated together are also
+    // adjacent in memory. Only the most recent allocation can be freed
+    // individually, everything else is freed by Clear().
+    // When built with ESOLVER_HUGE_PAGE_ARENAS, chunks are regions
+    // mapped with MAP_HUGETLB if the system has huge pages reserved,
+    // and otherwise advised to be backed by transparent huge pages
+    class BumpArena
+    {
+    private:
+        vector<pair<char*, uint64>> Chunks;
+        char* Top;
+        char* Limit;
+        uint64 ChunkSize;
+        uint64 BytesAllocated;
+
+        static inline char* MapChunk(uint64& Size)
+        {
+#if defined ESOLVER_HUGE_PAGE_ARENAS
+            Size = max(Size, ESOLVER_HUGE_PAGE_REGION_SIZE);
+            Size = (Size + ESOLVER_HUGE_PAGE_SIZE - 1) & ~(ESOLVER_HUGE_PAGE_SIZE - 1);
+#if defined MAP_HUGETLB
+            // Tried until it first fails, huge pages are rarely reserved
+            static bool HugeTLBAvailable = true;
+            if (HugeTLBAvailable) {
+                auto Chunk = mmap(nullptr, Size, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (Chunk != MAP_FAILED) {
+                    return (char*)Chunk;
+                }
+                HugeTLBAvailable = false;
+            }
+#endif /* MAP_HUGETLB */
+            auto Chunk = mmap(nullptr, Size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (Chunk == MAP_FAILED) {
+                return nullptr;
+            }
+#if defined MADV_HUGEPAGE
+            madvise(Chunk, Size, MADV_HUGEPAGE);
+#endif /* MADV_HUGEPAGE */
+            return (char*)Chunk;
+#else
+            return (char*)malloc(Size);
+#endif /* ESOLVER_HUGE_PAGE_ARENAS */
+        }
+
+        static inline void UnmapChunk(char* Chunk, uint64 Size)
+        {
+#if defined ESOLVER_HUGE_PAGE_ARENAS
+            munmap(Chunk, Size);
+#else
+            free(Chunk);
+#endif /* ESOLVER_HUGE_PAGE_ARENAS */
+        }
+
+        inline void NewChunk(uint64 MinSize)
+        {
+            uint64 Size = max(ChunkSize, MinSize);
+            auto Chunk = MapChunk(Size);
+            if (Chunk == nullptr) {
+                throw OutOfMemoryException("Out of Memory!");
+            }
+            Chunks.push_back(make_pair(Chunk, Size));
+            Top = Chunk;
+            Limit = Chunk + Size;
+        }
+
+    public:
+        inline BumpArena(uint64 ChunkSize = (1 << 20))
+            : Top(nullptr), Limit(nullptr), ChunkSize(ChunkSize), BytesAllocated(0)
+        {
+            // Nothing here
+        }
+
+        inline ~BumpArena()
+        {
+            Clear();
+        }
+
+        BumpArena(const BumpArena& Other) = delete;
+        BumpArena& operator = (const BumpArena& Other) = delete;
+
+        // Eight byte aligned
+        inline void* Allocate(uint64 Size)
+        {
+            Size = (Size + 7) & ~((uint64)7);
+            if (UNLIKELY((uint64)(Limit - Top) < Size)) {
+                NewChunk(Size);
+            }
+            auto Retval = Top;
+            Top += Size;
+            BytesAllocated += Size;
+            return Retval;
+        }
+
+        // Ptr must be the most recent allocation
+        inline void FreeLast(void* Ptr)
+        {
+            BytesAllocated -= (Top - (char*)Ptr);
+            Top = (char*)Ptr;
+        }
+
+        inline void Clear()
+        {
+            for (auto const& Chunk : Chunks) {
+                UnmapChunk(Chunk.first, Chunk.second);
+            }
+            Chunks.clear();
+            Top = Limit = nullptr;
+            BytesAllocated = 0;
+        }
+
+        inline uint64 GetBytesAllocated() const
+        {
+            return BytesAllocated;
+        }
+    };
+
+} /* End namespace */
+
+//
+// BumpArena.hpp ends here
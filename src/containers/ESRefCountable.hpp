@@ -43,12 +43,25 @@
 
 #include "../common/ESolverForwardDecls.hpp"
 
+#if defined ESOLVER_ATOMIC_REFCOUNTS
+#include <atomic>
+#endif
+
 namespace ESolver {
 
+    // Reference counts are plain integers, unless the build defines
+    // ESOLVER_ATOMIC_REFCOUNTS, in which case they are atomic and
+    // objects can be shared by threads
+#if defined ESOLVER_ATOMIC_REFCOUNTS
+    typedef atomic<int32> ESRefCounterType;
+#else
+    typedef int32 ESRefCounterType;
+#endif
+
     class ESRefCountable
     {
     private:
-        int32 __RefCounter;
+        ESRefCounterType __RefCounter;
 
     public:
         inline ESRefCountable()
@@ -73,8 +86,7 @@ namespace ESolver {
 
         inline void __DecRefCount()
         {
-            __RefCounter--;
-            if(__RefCounter <= 0) {
+            if(--__RefCounter <= 0) {
                 delete this;
             }
         }
@@ -100,6 +100,13 @@ namespace ESolver {
             __Assign(Other.__Ptr);
         }
 
+        // Moves do not touch the reference count
+        inline ESSmartPtr(ESSmartPtr&& Other) noexcept
+        {
+            this->__Ptr = Other.__Ptr;
+            Other.__Ptr = NULL;
+        }
+
         ~ESSmartPtr()
         {
             __Free();
@@ -116,6 +123,19 @@ namespace ESolver {
             return (*this);
         }
 
+        inline ESSmartPtr& operator = (ESSmartPtr&& Other) noexcept
+        {
+            if(this != &Other) {
+                T* OldPtr = this->__Ptr;
+                this->__Ptr = Other.__Ptr;
+                Other.__Ptr = NULL;
+                if(OldPtr != NULL) {
+                    OldPtr->__DecRefCount();
+                }
+            }
+            return (*this);
+        }
+
         inline ESSmartPtr& operator = (T* __Ptr)
         {
             __Assign(__Ptr);
@@ -270,6 +290,13 @@ namespace ESolver {
             __Assign(Other.__Ptr);
         }
 
+        // Moves do not touch the reference count
+        inline ConstESSmartPtr(ConstESSmartPtr&& Other) noexcept
+        {
+            __Ptr = Other.__Ptr;
+            Other.__Ptr = NULL;
+        }
+
 
         ~ConstESSmartPtr()
         {
@@ -287,6 +314,19 @@ namespace ESolver {
             return (*this);
         }
 
+        inline ConstESSmartPtr<T>& operator = (ConstESSmartPtr<T>&& Other) noexcept
+        {
+            if(this != &Other) {
+                T* OldPtr = const_cast<T*>(this->__Ptr);
+                this->__Ptr = Other.__Ptr;
+                Other.__Ptr = NULL;
+                if(OldPtr != NULL) {
+                    OldPtr->__DecRefCount();
+                }
+            }
+            return (*this);
+        }
+
         inline ConstESSmartPtr& operator = (T* __Ptr)
         {
             __Assign(__Ptr);
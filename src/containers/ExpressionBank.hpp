@@ -0,0 +1,151 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// A flat store for the expressions cached by the enumerators
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "../common/ESolverForwardDecls.hpp"
+#include "../exceptions/ESException.hpp"
+
+namespace ESolver {
+
+    // The half open range [Begin, End) of expression ids
+    struct ExpIdSpan
+    {
+        uint32 Begin;
+        uint32 End;
+    };
+
+    // The expressions of a grammar node at a cost: NumSpans spans
+    // starting at FirstSpan in the span arena of the bank
+    struct ExpBankEntry
+    {
+        uint32 FirstSpan;
+        uint32 NumSpans;
+        uint64 NumExps;
+
+        inline uint64 Size() const
+        {
+            return NumExps;
+        }
+    };
+
+    // All expressions live in one arena and are identified by their
+    // 32 bit index in it. The expressions of a function or a leaf node
+    // at a cost get consecutive ids, so that they form a single span,
+    // and the expressions of a non-terminal at a cost are the spans of
+    // its expansions at that cost.
+    // Nodes are populated recursively, and the expressions of a node
+    // are only moved to the arena once it is complete. Until then they
+    // are kept on a stack of pending expressions: a node that starts
+    // populating opens a frame at the top of the stack, and the frames
+    // of the nodes it populates in turn are closed before it adds its
+    // next expression. Spans of non-terminals are collected the same way
+    class ExpressionBank
+    {
+    private:
+        vector<const GenExpressionBase*> Exps;
+        vector<ExpIdSpan> Spans;
+        vector<const GenExpressionBase*> PendingExps;
+        vector<ExpIdSpan> PendingSpans;
+
+        inline ExpBankEntry MakeEntry(uint32 SpanFrame, uint64 NumExps)
+        {
+            ExpBankEntry Retval;
+            Retval.FirstSpan = Spans.size();
+            Retval.NumSpans = PendingSpans.size() - SpanFrame;
+            Retval.NumExps = NumExps;
+            Spans.insert(Spans.end(), PendingSpans.begin() + SpanFrame, PendingSpans.end());
+            PendingSpans.resize(SpanFrame);
+            return Retval;
+        }
+
+    public:
+        inline uint32 OpenExps()
+        {
+            return PendingExps.size();
+        }
+
+        inline void PushBack(const GenExpressionBase* Exp)
+        {
+            PendingExps.push_back(Exp);
+        }
+
+        // Assigns ids to the expressions pushed since the frame was opened
+        inline ExpBankEntry CloseExps(uint32 Frame)
+        {
+            const uint32 Begin = Exps.size();
+            const uint64 NumExps = PendingExps.size() - Frame;
+            if (UNLIKELY(Begin + NumExps > (uint64)UINT32_MAX)) {
+                throw OutOfMemoryException((string)"Expression bank is out of 32 bit ids");
+            }
+            Exps.insert(Exps.end(), PendingExps.begin() + Frame, PendingExps.end());
+            PendingExps.resize(Frame);
+
+            const uint32 SpanFrame = PendingSpans.size();
+            if (NumExps > 0) {
+                PendingSpans.push_back({ Begin, (uint32)Exps.size() });
+            }
+            return MakeEntry(SpanFrame, NumExps);
+        }
+
+        inline uint32 OpenSpans()
+        {
+            return PendingSpans.size();
+        }
+
+        inline void Merge(const ExpBankEntry& Entry)
+        {
+            PendingSpans.insert(PendingSpans.end(), Spans.begin() + Entry.FirstSpan,
+                                Spans.begin() + Entry.FirstSpan + Entry.NumSpans);
+        }
+
+        // Makes an entry of the spans merged since the frame was opened
+        inline ExpBankEntry CloseSpans(uint32 Frame)
+        {
+            uint64 NumExps = 0;
+            for (auto it = PendingSpans.begin() + Frame; it != PendingSpans.end(); ++it) {
+                NumExps += it->End - it->Begin;
+            }
+            return MakeEntry(Frame, NumExps);
+        }
+
+        // Invalidated when an entry is closed
+        inline const ExpIdSpan* GetSpans(const ExpBankEntry& Entry) const
+        {
+            return Spans.data() + Entry.FirstSpan;
+        }
+
+        inline const GenExpressionBase* Get(uint32 ID) const
+        {
+            return Exps[ID];
+        }
+
+        inline uint64 GetNumExps() const
+        {
+            return Exps.size();
+        }
+
+        inline uint64 GetNumSpans() const
+        {
+            return Spans.size();
+        }
+
+        inline void Clear()
+        {
+            Exps.clear();
+            Spans.clear();
+            PendingExps.clear();
+            PendingSpans.clear();
+        }
+    };
+
+} /* End namespace */
+
+//
+// ExpressionBank.hpp ends here
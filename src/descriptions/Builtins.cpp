@@ -50,6 +50,7 @@
 #include "../values/ValueManager.hpp"
 #include "../solverutils/TypeManager.hpp"
 #include "../logics/LIALogic.hpp"
+#include "../logics/StringLogic.hpp"
 #include "../logics/BVLogic.hpp"
 
 namespace ESolver {
@@ -71,7 +72,28 @@ namespace ESolver {
         TheValue = ((Args[0]->GetValue() != 0 && Args[1]->GetValue() != 0) ? 1 : 0);
         new (Result) ConcreteValueBase(Args[0]->GetType(), TheValue);
     }
+
+    bool AndConcreteFunctor::EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                            uint64* Result)
+    {
+        for (uint32 w = 0; w < NumWords; ++w) {
+            Result[w] = Args[0][w] & Args[1][w];
+        }
+        return true;
+    }
     
+    bool AndConcreteFunctor::IsLazy() const
+    {
+        return true;
+    }
+
+    uint32 AndConcreteFunctor::ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                            ConcreteValueBase* Result)
+    {
+        // and(false, b) = false, and(true, b) = b
+        return (ArgValue->GetValue() == 0 ? ArgIndex : ArgIndex + 1);
+    }
+
     string AndConcreteFunctor::ToString() const
     {
         return "AndConcreteFunctor";
@@ -95,6 +117,27 @@ namespace ESolver {
         new (Result) ConcreteValueBase(Args[0]->GetType(), TheValue);
     }
 
+    bool OrConcreteFunctor::EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                           uint64* Result)
+    {
+        for (uint32 w = 0; w < NumWords; ++w) {
+            Result[w] = Args[0][w] | Args[1][w];
+        }
+        return true;
+    }
+
+    bool OrConcreteFunctor::IsLazy() const
+    {
+        return true;
+    }
+
+    uint32 OrConcreteFunctor::ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                           ConcreteValueBase* Result)
+    {
+        // or(true, b) = true, or(false, b) = b
+        return (ArgValue->GetValue() != 0 ? ArgIndex : ArgIndex + 1);
+    }
+
     string OrConcreteFunctor::ToString() const
     {
         return "OrConcreteFunctor";
@@ -118,6 +161,15 @@ namespace ESolver {
         new (Result) ConcreteValueBase(Args[0]->GetType(), TheValue);
     }
 
+    bool NegConcreteFunctor::EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                            uint64* Result)
+    {
+        for (uint32 w = 0; w < NumWords; ++w) {
+            Result[w] = ~Args[0][w];
+        }
+        return true;
+    }
+
     string NegConcreteFunctor::ToString() const
     {
         return "NegConcreteFunctor";
@@ -141,6 +193,31 @@ namespace ESolver {
         new (Result) ConcreteValueBase(Args[0]->GetType(), TheValue);
     }
 
+    bool ImpliesConcreteFunctor::EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                                uint64* Result)
+    {
+        for (uint32 w = 0; w < NumWords; ++w) {
+            Result[w] = ~Args[0][w] | Args[1][w];
+        }
+        return true;
+    }
+
+    bool ImpliesConcreteFunctor::IsLazy() const
+    {
+        return true;
+    }
+
+    uint32 ImpliesConcreteFunctor::ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                                ConcreteValueBase* Result)
+    {
+        // (=> false b) = true, (=> true b) = b
+        if (ArgValue->GetValue() == 0) {
+            new (Result) ConcreteValueBase(ArgValue->GetType(), (int64)1);
+            return LAZY_EVAL_DONE;
+        }
+        return ArgIndex + 1;
+    }
+
     string ImpliesConcreteFunctor::ToString() const
     {
         return "ImpliesConcreteFunctor";
@@ -165,6 +242,15 @@ namespace ESolver {
         new (Result) ConcreteValueBase(Args[0]->GetType(), TheValue);
     }
 
+    bool IffConcreteFunctor::EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                            uint64* Result)
+    {
+        for (uint32 w = 0; w < NumWords; ++w) {
+            Result[w] = ~(Args[0][w] ^ Args[1][w]);
+        }
+        return true;
+    }
+
     string IffConcreteFunctor::ToString() const
     {
         return "IffConcreteFunctor";
@@ -188,6 +274,16 @@ namespace ESolver {
         new (Result) ConcreteValueBase(Args[0]->GetType(), TheValue);
     }
 
+    bool EQConcreteFunctor::EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                           uint64* Result)
+    {
+        // Only ever called with Boolean arguments
+        for (uint32 w = 0; w < NumWords; ++w) {
+            Result[w] = ~(Args[0][w] ^ Args[1][w]);
+        }
+        return true;
+    }
+
     string EQConcreteFunctor::ToString() const
     {
         return "EQConcreteFunctor";
@@ -210,6 +306,28 @@ namespace ESolver {
         new (Result) ConcreteValueBase(Args[1]->GetType(), TheValue);
     }
 
+    bool ITEConcreteFunctor::EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                            uint64* Result)
+    {
+        // Only ever called with Boolean branches
+        for (uint32 w = 0; w < NumWords; ++w) {
+            Result[w] = (Args[0][w] & Args[1][w]) | (~Args[0][w] & Args[2][w]);
+        }
+        return true;
+    }
+
+    bool ITEConcreteFunctor::IsLazy() const
+    {
+        return true;
+    }
+
+    uint32 ITEConcreteFunctor::ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                            ConcreteValueBase* Result)
+    {
+        // Only the branch that is taken is evaluated
+        return (ArgValue->GetValue() != 0 ? (uint32)1 : (uint32)2);
+    }
+
     string ITEConcreteFunctor::ToString() const
     {
         return "ITEConcreteFunctor";
@@ -234,6 +352,15 @@ namespace ESolver {
         new (Result) ConcreteValueBase(Args[0]->GetType(), TheValue);
     }
 
+    bool XorConcreteFunctor::EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                            uint64* Result)
+    {
+        for (uint32 w = 0; w < NumWords; ++w) {
+            Result[w] = Args[0][w] ^ Args[1][w];
+        }
+        return true;
+    }
+
     string XorConcreteFunctor::ToString() const
     {
         return "ITEConcreteFunctor";
@@ -441,18 +568,42 @@ namespace ESolver {
         ArgVectorIntITE.push_back(IntType);
         ArgVectorIntITE.push_back(IntType);
 
+        TrueValue = ValMgr->GetValue(BoolType, 1);
+        FalseValue = ValMgr->GetValue(BoolType, 0);
+
+        RewriteFacts AndFacts;
+        AndFacts.LeftIdentity = AndFacts.RightIdentity = TrueValue;
+        AndFacts.LeftAnnihilator = AndFacts.RightAnnihilator = FalseValue;
+        AndFacts.Idempotent = AndFacts.Associative = true;
+
+        RewriteFacts OrFacts;
+        OrFacts.LeftIdentity = OrFacts.RightIdentity = FalseValue;
+        OrFacts.LeftAnnihilator = OrFacts.RightAnnihilator = TrueValue;
+        OrFacts.Idempotent = OrFacts.Associative = true;
+
+        RewriteFacts NotFacts;
+        NotFacts.Involutive = true;
+
+        RewriteFacts ImpliesFacts;
+        ImpliesFacts.LeftIdentity = TrueValue;
+        ImpliesFacts.RightAnnihilator = TrueValue;
+
+        RewriteFacts XorFacts;
+        XorFacts.LeftIdentity = XorFacts.RightIdentity = FalseValue;
+        XorFacts.Associative = true;
+
         CreateFunction("and", ArgVectorBin, BoolType, new AndSymbolicFunctor(),
-                       new AndConcreteFunctor(), true, true);
+                       new AndConcreteFunctor(), true, true, 1, &AndFacts);
         CreateFunction("or", ArgVectorBin, BoolType, new OrSymbolicFunctor(),
-                       new OrConcreteFunctor(), true, true);
+                       new OrConcreteFunctor(), true, true, 1, &OrFacts);
         CreateFunction("not", ArgVectorUn, BoolType, new NegSymbolicFunctor(),
-                       new NegConcreteFunctor(), false, true);
+                       new NegConcreteFunctor(), false, true, 1, &NotFacts);
         CreateFunction("=>", ArgVectorBin, BoolType, new ImpliesSymbolicFunctor(),
-                       new ImpliesConcreteFunctor(), false, true);
+                       new ImpliesConcreteFunctor(), false, true, 1, &ImpliesFacts);
         CreateFunction("<=>", ArgVectorBin, BoolType, new IffSymbolicFunctor(),
                        new IffConcreteFunctor(), true, true);
         CreateFunction("xor", ArgVectorBin, BoolType, new XorSymbolicFunctor(),
-                       new XorConcreteFunctor(), true, true);
+                       new XorConcreteFunctor(), true, true, 1, &XorFacts);
 
         // Add the EQ op for integers
         // EQ is always symmetric by definition
@@ -466,14 +617,14 @@ namespace ESolver {
         // Add the ITE Op for integers
         CreateFunction("ite", ArgVectorIntITE, IntType, new ITESymbolicFunctor(),
                        new ITEConcreteFunctor(), false, true);
-        
-        TrueValue = ValMgr->GetValue(BoolType, 1);
-        FalseValue = ValMgr->GetValue(BoolType, 0);
 
         // Load logics
         auto LIA = new LIALogic(this);
         LIA->Init();
         LoadedLogics.push_back(LIA);
+        auto Strings = new StringLogic(this);
+        Strings->Init();
+        LoadedLogics.push_back(Strings);
         auto BV = new BVLogic(this);
         BV->Init();
         LoadedLogics.push_back(BV);
@@ -66,6 +66,11 @@ namespace ESolver {
         using ConcFunctorBase::ConcFunctorBase;
         virtual ~AndConcreteFunctor();
         virtual void operator () (EvalMap ChildEvals, ConcreteValueBase* Result) override;
+        virtual bool EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                    uint64* Result) override;
+        virtual bool IsLazy() const override;
+        virtual uint32 ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                    ConcreteValueBase* Result) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -76,6 +81,11 @@ namespace ESolver {
         using ConcFunctorBase::ConcFunctorBase;
         virtual ~OrConcreteFunctor();
         virtual void operator () (EvalMap ChildEvals, ConcreteValueBase* Result) override;
+        virtual bool EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                    uint64* Result) override;
+        virtual bool IsLazy() const override;
+        virtual uint32 ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                    ConcreteValueBase* Result) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -86,6 +96,8 @@ namespace ESolver {
         using ConcFunctorBase::ConcFunctorBase;
         virtual ~NegConcreteFunctor();
         virtual void operator () (EvalMap ChildEvals, ConcreteValueBase* Result) override;
+        virtual bool EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                    uint64* Result) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -96,6 +108,11 @@ namespace ESolver {
         using ConcFunctorBase::ConcFunctorBase;
         virtual ~ImpliesConcreteFunctor();
         virtual void operator () (EvalMap ChildEvals, ConcreteValueBase* Result) override;
+        virtual bool EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                    uint64* Result) override;
+        virtual bool IsLazy() const override;
+        virtual uint32 ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                    ConcreteValueBase* Result) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -106,6 +123,8 @@ namespace ESolver {
         using ConcFunctorBase::ConcFunctorBase;
         virtual ~IffConcreteFunctor();
         virtual void operator () (EvalMap ChildEvals, ConcreteValueBase* Result) override;
+        virtual bool EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                    uint64* Result) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -117,6 +136,8 @@ namespace ESolver {
         using ConcFunctorBase::ConcFunctorBase;
         virtual ~EQConcreteFunctor();
         virtual void operator () (EvalMap ChildEvals, ConcreteValueBase* Result) override;
+        virtual bool EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                    uint64* Result) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -128,6 +149,11 @@ namespace ESolver {
         using ConcFunctorBase::ConcFunctorBase;
         virtual ~ITEConcreteFunctor();
         virtual void operator () (EvalMap ChildEvals, ConcreteValueBase* Result) override;
+        virtual bool EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                    uint64* Result) override;
+        virtual bool IsLazy() const override;
+        virtual uint32 ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                    ConcreteValueBase* Result) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
    };
@@ -224,6 +250,8 @@ namespace ESolver {
         using ConcFunctorBase::ConcFunctorBase;
         virtual ~XorConcreteFunctor();
         virtual void operator () (EvalMap ChildEvals, ConcreteValueBase* Result) override;
+        virtual bool EvaluatePacked(PackedEvalMap Args, uint32 NumWords,
+                                    uint64* Result) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
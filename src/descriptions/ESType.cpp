@@ -133,6 +133,49 @@ namespace ESolver {
         HashValue = boost::hash_value(ToString());
     }
 
+    ESStringType::ESStringType(TheoremProver* TP, StringStore* Store)
+        : ESFixedTypeBase(BaseTypeString, TP->CreateStringType()), Store(Store)
+    {
+        // Nothing here
+    }
+
+    ESStringType::ESStringType(StringStore* Store)
+        : ESFixedTypeBase(BaseTypeString, SMTType()), Store(Store)
+    {
+        // Nothing here
+    }
+
+    ESStringType::~ESStringType()
+    {
+        // Nothing here
+    }
+
+    StringStore* ESStringType::GetStore() const
+    {
+        return Store;
+    }
+
+    bool ESStringType::Equals(const ESTypeBase& Other) const
+    {
+        return (Other.As<ESStringType>() != nullptr);
+    }
+
+    string ESStringType::ToString() const
+    {
+        return "String";
+    }
+
+    string ESStringType::ToSimpleString() const
+    {
+        return ToString();
+    }
+
+    void ESStringType::ComputeHashValue() const
+    {
+        HashValid = true;
+        HashValue = boost::hash_value(ToString());
+    }
+
     ESBoolType::ESBoolType(TheoremProver* TP)
         : ESFixedTypeBase(BaseTypeBool, TP->CreateBoolType())
     {
@@ -335,14 +378,14 @@ namespace ESolver {
         return (EnumValueIDSet.find(EVID) != EnumValueIDSet.end());
     }
 
-    ESBVType::ESBVType(TheoremProver* TP, uint32 Size)
-        : ESFixedTypeBase(BaseTypeBitVector, TP->CreateBVType(Size)), Size(Size)
+    ESBVType::ESBVType(TheoremProver* TP, uint32 Size, WideBVStore* Store)
+        : ESFixedTypeBase(BaseTypeBitVector, TP->CreateBVType(Size)), Size(Size), Store(Store)
     {
         // Nothing here
     }
 
-    ESBVType::ESBVType(uint32 Size)
-        : ESFixedTypeBase(BaseTypeBitVector, SMTType()), Size(Size)
+    ESBVType::ESBVType(uint32 Size, WideBVStore* Store)
+        : ESFixedTypeBase(BaseTypeBitVector, SMTType()), Size(Size), Store(Store)
     {
         // Nothing here
     }
@@ -383,6 +426,11 @@ namespace ESolver {
         return Size;
     }
 
+    WideBVStore* ESBVType::GetStore() const
+    {
+        return Store;
+    }
+
     ESArrayType::ESArrayType(TheoremProver* TP,
                              const ESFixedTypeBase* IndexType,
                              const ESFixedTypeBase* ValueType)
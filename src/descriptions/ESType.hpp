@@ -58,6 +58,7 @@ namespace ESolver {
         BaseTypeReal,
         BaseTypeArray,
         BaseTypeFunction,
+        BaseTypeString,
         // Insert any additional base types
         // before this line
         BaseTypeUndefined = UINT32_MAX
@@ -131,6 +132,27 @@ namespace ESolver {
         virtual string ToSimpleString() const override;
     };
     
+    class ESStringType : public ESFixedTypeBase
+    {
+    private:
+        // Values of this type are handles into the store
+        StringStore* Store;
+
+    protected:
+        virtual void ComputeHashValue() const override;
+
+    public:
+        ESStringType(StringStore* Store);
+        ESStringType(TheoremProver* TP, StringStore* Store);
+        virtual ~ESStringType();
+
+        StringStore* GetStore() const;
+
+        virtual bool Equals(const ESTypeBase& Other) const override;
+        virtual string ToString() const override;
+        virtual string ToSimpleString() const override;
+    };
+
     class ESBoolType : public ESFixedTypeBase
     {
     protected:
@@ -201,10 +223,12 @@ namespace ESolver {
 
     private:
         uint32 Size;
+        // Values wider than 64 bits are handles into the store
+        WideBVStore* Store;
 
     public:
-        ESBVType(uint32 Size);
-        ESBVType(TheoremProver* TP, uint32 Size);
+        ESBVType(uint32 Size, WideBVStore* Store);
+        ESBVType(TheoremProver* TP, uint32 Size, WideBVStore* Store);
         virtual ~ESBVType();
 
         virtual bool Equals(const ESTypeBase& Other) const override;
@@ -212,6 +236,7 @@ namespace ESolver {
         virtual string ToSimpleString() const override;
         
         uint32 GetSize() const;
+        WideBVStore* GetStore() const;
     };
 
     class ESArrayType : public ESFixedTypeBase
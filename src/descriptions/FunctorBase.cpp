@@ -40,6 +40,7 @@
 #include "FunctorBase.hpp"
 #include "../z3interface/Z3Objects.hpp"
 #include "../z3interface/TheoremProver.hpp"
+#include "../values/ConcreteValueBase.hpp"
 
 namespace ESolver {
 
@@ -68,6 +69,51 @@ namespace ESolver {
         return FunctorID;
     }
 
+    void ConcFunctorBase::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                        int64* Result, uint8* Exceptions)
+    {
+        // The columns carry no types, the scalar functors
+        // only look at the values of their arguments
+        vector<ConcreteValueBase> ArgValues(NumArgs);
+        vector<const ConcreteValueBase*> ArgPtrs(NumArgs);
+        for (uint32 i = 0; i < NumArgs; ++i) {
+            ArgPtrs[i] = &ArgValues[i];
+        }
+        ConcreteValueBase LaneResult;
+
+        for (uint32 l = 0; l < NumLanes; ++l) {
+            for (uint32 i = 0; i < NumArgs; ++i) {
+                ArgValues[i].Set(nullptr, Args[i][l]);
+            }
+            (*this)(ArgPtrs.data(), &LaneResult);
+            Result[l] = LaneResult.GetValue();
+            if (ConcreteException) {
+                ConcreteException = false;
+                Exceptions[l] |= BATCH_LANE_EXCEPTION;
+            }
+            if (ConcreteOverflow) {
+                ConcreteOverflow = false;
+                Exceptions[l] |= BATCH_LANE_OVERFLOW;
+            }
+        }
+    }
+
+    bool ConcFunctorBase::EvaluatePacked(PackedEvalMap Args, uint32 NumWords, uint64* Result)
+    {
+        return false;
+    }
+
+    bool ConcFunctorBase::IsLazy() const
+    {
+        return false;
+    }
+
+    uint32 ConcFunctorBase::ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                         ConcreteValueBase* Result)
+    {
+        return LAZY_EVAL_CONTINUE;
+    }
+
     SymbFunctorBase::SymbFunctorBase()
         : FunctorID(SymbFunctorUIDGenerator.GetUID())
     {
@@ -45,6 +45,15 @@
 #if !defined __ESOLVER_FUNCTOR_BASE_HPP
 #define __ESOLVER_FUNCTOR_BASE_HPP
 
+// Flags for the lanes of a batch evaluation
+#define BATCH_LANE_EXCEPTION ((uint8)0x1)
+#define BATCH_LANE_OVERFLOW ((uint8)0x2)
+
+// Return values of ConcFunctorBase::ShortCircuit(), other
+// return values are the index of an argument
+#define LAZY_EVAL_CONTINUE ((uint32)0xFFFFFFFF)
+#define LAZY_EVAL_DONE ((uint32)0xFFFFFFFE)
+
 namespace ESolver {
 
     extern UIDGenerator ConcFunctorUIDGenerator;
@@ -77,6 +86,44 @@ namespace ESolver {
 
         virtual void operator () (EvalMap ChildEvals, ConcreteValueBase* Result) = 0;
 
+        // Evaluates the functor on NumLanes independent argument tuples
+        // at once: Args[i][l] is the value of the i-th argument in lane l.
+        // Lanes on which the operation raises a concrete exception get
+        // BATCH_LANE_EXCEPTION or'ed into their entry in Exceptions,
+        // lanes on which integer arithmetic overflows get
+        // BATCH_LANE_OVERFLOW. All other entries are left as they were,
+        // so that masks accumulate over a whole expression.
+        // Results of such lanes are unspecified.
+        // The default implementation goes through operator () lane by
+        // lane, logics override it with straight loops over the columns
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions);
+
+        // Evaluates the functor on Boolean arguments packed into
+        // bitsets: Args[i][w] holds the values of the i-th argument
+        // in lanes 64 * w to 64 * w + 63. Functors on Booleans are
+        // bitwise operations on the words. Bits beyond the last lane
+        // may be set in Result. Returns false if the functor has no
+        // packed form, the default
+        virtual bool EvaluatePacked(PackedEvalMap Args, uint32 NumWords, uint64* Result);
+
+        // Lazy functors may decide their result before all of their
+        // arguments are evaluated. The evaluators then evaluate the
+        // arguments left to right and, after each one but the last,
+        // call ShortCircuit() with the index and value of the argument
+        // just evaluated. It returns:
+        // - LAZY_EVAL_CONTINUE to go on with the next argument
+        // - LAZY_EVAL_DONE after setting Result, no more arguments
+        //   are evaluated
+        // - the index of an argument whose value is the result, only
+        //   that argument is evaluated if it was not evaluated yet
+        // The functor is applied as usual once all arguments are
+        // evaluated. Exceptions in arguments that are skipped are
+        // never raised
+        virtual bool IsLazy() const;
+        virtual uint32 ShortCircuit(uint32 ArgIndex, const ConcreteValueBase* ArgValue,
+                                    ConcreteValueBase* Result);
+
         // A stringification method which needs to be implemented by clients
         virtual string ToString() const = 0;
         // A clone method that needs to be implemented by clients
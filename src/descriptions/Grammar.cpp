@@ -186,6 +186,18 @@ namespace ESolver {
         return Get<GrammarConst>(this, Op);
     }
 
+    GrammarConstHole* Grammar::MakeConstHole(const ESFixedTypeBase* Type)
+    {
+        // Every occurrence of (Constant <Type>) is a node of its own. The
+        // solver gives each use of the node in a template a separate value
+        auto HoleName = "__ConstHole_" + Name + "_" + to_string(ConstHoles.size());
+        auto HoleOp = Solver->CreateQuantifiedVariable(HoleName, Type);
+        auto Retval = new GrammarConstHole(this, HoleOp);
+        ConstHoles.push_back(Retval);
+        GNSet.insert(Retval);
+        return Retval;
+    }
+
     GrammarFunc* Grammar::MakeFunc(const string& FuncName, const vector<GrammarNode*>& Args)
     {
         // extract the types
@@ -262,6 +274,15 @@ namespace ESolver {
         }
     }
 
+    vector<const GrammarNonTerminal*> Grammar::GetNonTerminals() const
+    {
+        vector<const GrammarNonTerminal*> Retval;
+        for (auto const& NTExpansions : ExpansionMap) {
+            Retval.push_back(NTExpansions.first);
+        }
+        return Retval;
+    }
+
     
 
     bool Grammar::InstantiateDFSNT(const NTExtNode& Node, CEMapType& CanonExpansions)
@@ -466,6 +487,11 @@ namespace ESolver {
         return FormalParamVars;
     }
 
+    const vector<GrammarConstHole*>& Grammar::GetConstHoles() const
+    {
+        return ConstHoles;
+    }
+
     uint32 Grammar::GetNumLetBoundVars() const
     {
         return LetBoundVars.size();
@@ -161,6 +161,7 @@ namespace ESolver {
         map<string, GrammarLetVar*> LetBoundVars;
         map<string, GrammarFPVar*> FormalParamVars;
         map<string, GrammarNonTerminal*> NonTerminalMap;
+        vector<GrammarConstHole*> ConstHoles;
         GrammarNodeSet GNSet;
         uint32 LetCounter;
         
@@ -209,6 +210,7 @@ namespace ESolver {
         GrammarConst* MakeConst(const string& ConstName);
         GrammarConst* MakeConst(const ConstOperator* Op);
         GrammarConst* MakeConstFromLiteral(const string& LiteralString, const ESFixedTypeBase* Type);
+        GrammarConstHole* MakeConstHole(const ESFixedTypeBase* Type);
         GrammarFunc* MakeFunc(const string& FuncName, const vector<GrammarNode*>& Args);
         GrammarLet* MakeLet(const map<GrammarLetVar*, GrammarNode*>& Bindings,
                             GrammarNode* BoundExpression);
@@ -221,10 +223,12 @@ namespace ESolver {
         const string& GetName() const;
         const vector<GrammarNode*>& GetExpansions(const string& NonTermName) const;
         const vector<GrammarNode*>& GetExpansions(const GrammarNonTerminal* NonTerm) const;
+        vector<const GrammarNonTerminal*> GetNonTerminals() const;
         string ToString() const;
 
         const map<string, GrammarLetVar*>& GetLetBoundVars() const;
         const map<string, GrammarFPVar*>& GetFormalParamVars() const;
+        const vector<GrammarConstHole*>& GetConstHoles() const;
 
         uint32 GetNumLetBoundVars() const;
     };
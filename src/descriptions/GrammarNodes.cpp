@@ -201,6 +201,37 @@ namespace ESolver {
         return (OtherPtr->GetOp()->GetID() == GetOp()->GetID());
     }
 
+    GrammarConstHole::GrammarConstHole(const Grammar* TheGrammar,
+                                       const UQVarOperator* Op)
+        : GrammarVarBase(TheGrammar, Op)
+    {
+        // Nothing here
+    }
+
+    GrammarConstHole::~GrammarConstHole()
+    {
+        // Nothing here
+    }
+
+    const UQVarOperator* GrammarConstHole::GetOp() const
+    {
+        return static_cast<const UQVarOperator*>(Op);
+    }
+
+    string GrammarConstHole::ToString() const
+    {
+        return "(Constant " + Type->ToString() + ")";
+    }
+
+    bool GrammarConstHole::operator == (const GrammarNode& Other) const
+    {
+        auto OtherPtr = Other.As<GrammarConstHole>();
+        if (OtherPtr == nullptr) {
+            return false;
+        }
+        return (OtherPtr->GetOp()->GetID() == GetOp()->GetID());
+    }
+
     GrammarConst::GrammarConst(const Grammar* TheGrammar,
                                const ConstOperator* Op)
         : GrammarNode(TheGrammar, Op->GetEvalType()), Op(Op)
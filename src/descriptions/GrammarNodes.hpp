@@ -146,6 +146,22 @@ namespace ESolver {
         virtual bool operator == (const GrammarNode& Other) const override;
     };
 
+    // A placeholder for an arbitrary constant of the given type.
+    // The value is left symbolic during enumeration and is solved for
+    // once a complete expression containing the hole is found
+    class GrammarConstHole : public GrammarVarBase
+    {
+    public:
+        GrammarConstHole(const Grammar* TheGrammar,
+                         const UQVarOperator* Op);
+        virtual ~GrammarConstHole();
+
+        const UQVarOperator* GetOp() const;
+
+        virtual string ToString() const override;
+        virtual bool operator == (const GrammarNode& Other) const override;
+    };
+
     class GrammarConst : public GrammarNode
     {
     private:
@@ -250,14 +250,24 @@ namespace ESolver {
         return ConstantValue;
     }
 
+    RewriteFacts::RewriteFacts()
+        : LeftIdentity(nullptr), RightIdentity(nullptr),
+          LeftAnnihilator(nullptr), RightAnnihilator(nullptr),
+          Idempotent(false), Involutive(false), Associative(false)
+    {
+        // Nothing here
+    }
+
     InterpretedFuncOperator::InterpretedFuncOperator(const string& Name, 
                                                      const ESFunctionType* FuncType,
                                                      ConcFunctorBase* ConcFunctor,
                                                      SymbFunctorBase* SymbFunctor,
                                                      bool Symmetric,
-                                                     uint32 Cost)
+                                                     uint32 Cost,
+                                                     const RewriteFacts& Facts)
         : FuncOperatorBase(Name, FuncType, Cost), 
-          ConcFunctor(ConcFunctor), SymbFunctor(SymbFunctor), Symmetric(Symmetric)
+          ConcFunctor(ConcFunctor), SymbFunctor(SymbFunctor), Symmetric(Symmetric),
+          Lazy(ConcFunctor != nullptr && ConcFunctor->IsLazy()), Facts(Facts)
     {
         // Nothing here
     }
@@ -288,6 +298,16 @@ namespace ESolver {
         return Symmetric;
     }
 
+    bool InterpretedFuncOperator::IsLazy() const
+    {
+        return Lazy;
+    }
+
+    const RewriteFacts& InterpretedFuncOperator::GetRewriteFacts() const
+    {
+        return Facts;
+    }
+
     MacroOperator::MacroOperator(const string& Name, const ESFunctionType* FuncType,
                                  const vector<Expression>& FormalParamExpressions,
                                  const Expression& MacroExpression, bool Symmetric, uint32 Cost)
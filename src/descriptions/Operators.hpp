@@ -191,24 +191,53 @@ namespace ESolver {
         const ConcreteValueBase* GetConstantValue() const;
     };
 
+    // Algebraic facts about an interpreted function, declared by the
+    // logic that defines it. The enumerator uses them to skip
+    // candidates that are equal to a smaller or a canonical one.
+    // Constants are values of the respective argument types,
+    // nullptr if the function has no such constant
+    struct RewriteFacts
+    {
+        // f(e, x) = x and f(x, e) = x respectively
+        const ConcreteValueBase* LeftIdentity;
+        const ConcreteValueBase* RightIdentity;
+        // f(a, x) = a and f(x, a) = a respectively
+        const ConcreteValueBase* LeftAnnihilator;
+        const ConcreteValueBase* RightAnnihilator;
+        // f(x, x) = x
+        bool Idempotent;
+        // f(f(x)) = x
+        bool Involutive;
+        // f(f(x, y), z) = f(x, f(y, z))
+        bool Associative;
+
+        RewriteFacts();
+    };
+
     class InterpretedFuncOperator : public FuncOperatorBase
     {
     protected:
         ConcFunctorBase* ConcFunctor;
         SymbFunctorBase* SymbFunctor;
         bool Symmetric;
+        // Cached from the concrete functor, checked on every evaluation
+        bool Lazy;
+        RewriteFacts Facts;
 
     public:
         InterpretedFuncOperator(const string& Name, const ESFunctionType* FuncType,
                                 ConcFunctorBase* ConcFunctor,
                                 SymbFunctorBase* SymbFunctor,
                                 bool Symmetric = false,
-                                uint32 Cost = 1);
+                                uint32 Cost = 1,
+                                const RewriteFacts& Facts = RewriteFacts());
         virtual ~InterpretedFuncOperator();
 
         ConcFunctorBase* GetConcFunctor() const;
         SymbFunctorBase* GetSymbFunctor() const;
         virtual bool IsSymmetric() const;
+        bool IsLazy() const;
+        const RewriteFacts& GetRewriteFacts() const;
     };
 
     class MacroOperator : public InterpretedFuncOperator
@@ -43,39 +43,47 @@
 #include "../utils/GNCostPair.hpp"
 #include "../descriptions/GrammarNodes.hpp"
 #include "../descriptions/Operators.hpp"
+#include "../descriptions/FunctorBase.hpp"
+#include "../values/ConcreteValueBase.hpp"
 #include "../solvers/ESolver.hpp"
 #include "../partitions/PartitionGenerator.hpp"
 #include "../partitions/SymPartitionGenerator.hpp"
-#include "../partitions/CrossProductGenerator.hpp"
 #include "../expressions/GenExpression.hpp"
+#include "../utils/MemoryBreakdown.hpp"
 
 namespace ESolver {
 
     // Implementation of the enumerator
     // private utility functions
-    inline GenExpTLVec*
+    inline const ExpBankEntry*
     CFGEnumeratorSingle::GetVecForGNCost(const GrammarNode* GN, uint32 Cost)
     {
         ExpsOfGNCost::const_iterator it = ExpRepository.find(GNCostPair(GN, Cost));
         if(it == ExpRepository.end()) {
             return nullptr;
         } else {
-            return it->second;
+            return &(it->second);
         }
     }
 
-    inline GenExpTLVec*
-    CFGEnumeratorSingle::MakeVecForGNCost(const GrammarNode* GN, uint32 Cost)
+    inline uint32
+    CFGEnumeratorSingle::GetMinCost(const GrammarNode* GN) const
     {
-        GNCostPair CP(GN, Cost);
-        ExpsOfGNCost::const_iterator it = ExpRepository.find(CP);
-        if(it == ExpRepository.end()) {
-            auto NewVec = new GenExpTLVec();
-            ExpRepository[CP] = NewVec;
-            return NewVec;
-        } else {
-            return it->second;
+        auto it = MinCosts.find(GN);
+        if (it == MinCosts.end()) {
+            return 1;
         }
+        return it->second;
+    }
+
+    inline bool
+    CFGEnumeratorSingle::IsKnownEmpty(const GrammarNode* GN, uint32 Cost)
+    {
+        if (Cost < GetMinCost(GN)) {
+            return true;
+        }
+        auto Vec = GetVecForGNCost(GN, Cost);
+        return (Vec != nullptr && Vec->Size() == 0);
     }
 
     inline uint32
@@ -110,21 +118,177 @@ namespace ESolver {
         ExpansionStack.pop_back();
     }
 
-    inline boost::pool<>* CFGEnumeratorSingle::GetPoolForSize(uint32 Size)
+    static inline bool IsConstantOf(const GenExpressionBase* Exp, const ConcreteValueBase* Value)
     {
-        auto it = CPPools.find(Size);
-        if (it == CPPools.end()) {
-            auto Retval = CPPools[Size] = new boost::pool<>(Size * sizeof(GenExpressionBase const*));
-            return Retval;
+        if (Value == nullptr) {
+            return false;
+        }
+        auto ConstExp = Exp->As<GenConstExpression>();
+        return (ConstExp != nullptr && ConstExp->GetOp()->GetConstantValue()->Equals(*Value));
+    }
+
+    inline bool CFGEnumeratorSingle::IsNonCanonical(const GrammarFunc* Func,
+                                                    const InterpretedFuncOperator* Op,
+                                                    GenExpressionBase const* const* Args) const
+    {
+        auto it = FuncHomes.find(Func);
+        if (it == FuncHomes.end() || it->second.first == nullptr) {
+            return false;
+        }
+        auto const Home = it->second.first;
+        auto const OnlyExpansionWithOp = it->second.second;
+        auto const& Facts = Op->GetRewriteFacts();
+        auto const& ArgNodes = Func->GetChildren();
+
+        if (ArgNodes.size() == 1) {
+            // f(f(x)) = x
+            if (Facts.Involutive && OnlyExpansionWithOp && ArgNodes[0] == Home) {
+                auto Inner = Args[0]->As<GenFuncExpression>();
+                return (Inner != nullptr && Inner->GetOp() == Op);
+            }
+            return false;
+        }
+        if (ArgNodes.size() != 2) {
+            return false;
+        }
+
+        // Each of these is equal to one of its arguments, which
+        // is a smaller expansion of the same non-terminal
+        if (ArgNodes[1] == Home && IsConstantOf(Args[0], Facts.LeftIdentity)) {
+            return true;
+        }
+        if (ArgNodes[0] == Home && IsConstantOf(Args[1], Facts.RightIdentity)) {
+            return true;
+        }
+        if (ArgNodes[0] == Home && IsConstantOf(Args[0], Facts.LeftAnnihilator)) {
+            return true;
+        }
+        if (ArgNodes[1] == Home && IsConstantOf(Args[1], Facts.RightAnnihilator)) {
+            return true;
+        }
+        if (Facts.Idempotent && ArgNodes[0] == Home && Args[0] == Args[1]) {
+            return true;
+        }
+
+        // Only right nested applications are built. With symmetric
+        // partitions the left argument is never the more expensive one,
+        // the right comb with the cheapest operand leftmost remains
+        if (Facts.Associative && OnlyExpansionWithOp &&
+            ArgNodes[0] == Home && ArgNodes[1] == Home) {
+            auto Inner = Args[0]->As<GenFuncExpression>();
+            return (Inner != nullptr && Inner->GetOp() == Op);
+        }
+        return false;
+    }
+
+    inline const LIAAffineForm* CFGEnumeratorSingle::GetAffineForm(const GenExpressionBase* Exp)
+    {
+        auto it = AffineForms.find(Exp);
+        if (it != AffineForms.end()) {
+            return &(it->second);
+        }
+        auto& Form = AffineForms[Exp];
+        auto FPExp = Exp->As<GenFPExpression>();
+        auto ConstExp = Exp->As<GenConstExpression>();
+        if (FPExp != nullptr) {
+            Form = LIAAffineForm::OfParam(FPExp->GetOp()->GetPosition());
+        } else if (ConstExp != nullptr) {
+            Form = LIAAffineForm(ConstExp->GetOp()->GetConstantValue()->GetValue());
         } else {
-            return it->second;
+            Form = LIAAffineForm::OfAtom(Exp);
+        }
+        return &Form;
+    }
+
+    inline bool CFGEnumeratorSingle::IsAffineDuplicate(const GrammarNode* GN,
+                                                       const InterpretedFuncOperator* Op,
+                                                       GenExpressionBase const* const* Args,
+                                                       uint32 Cost, bool& HasForm)
+    {
+        HasForm = false;
+        auto Home = AffineHomes.find(GN);
+        if (Home == AffineHomes.end()) {
+            return false;
+        }
+        const uint32 Arity = Op->GetArity();
+        if (ArgFormScratch.size() < Arity) {
+            ArgFormScratch.resize(Arity);
+        }
+        for (uint32 i = 0; i < Arity; ++i) {
+            ArgFormScratch[i] = GetAffineForm(Args[i]);
+        }
+        if (!LIAAffineForm::Apply(Op, ArgFormScratch.data(), FormScratch)) {
+            return false;
+        }
+        HasForm = true;
+
+        auto& FormCosts = AffineFormCosts[Home->second];
+        auto it = FormCosts.find(FormScratch);
+        if (it == FormCosts.end()) {
+            FormCosts[FormScratch] = Cost;
+            return false;
+        } else if (it->second <= Cost) {
+            return true;
+        } else {
+            it->second = Cost;
+            return false;
+        }
+    }
+
+    inline const ConstOperator* CFGEnumeratorSingle::FoldGround(const InterpretedFuncOperator* Op,
+                                                                GenExpressionBase const* const* Args)
+    {
+        const uint32 Arity = Op->GetArity();
+        FoldArgValues.resize(Arity);
+        for (uint32 i = 0; i < Arity; ++i) {
+            auto ConstExp = Args[i]->As<GenConstExpression>();
+            if (ConstExp != nullptr) {
+                FoldArgValues[i] = ConstExp->GetOp()->GetConstantValue();
+                continue;
+            }
+            auto it = FoldedConsts.find(Args[i]);
+            if (it == FoldedConsts.end()) {
+                return nullptr;
+            }
+            FoldArgValues[i] = it->second->GetConstantValue();
+        }
+
+        ConcreteValueBase Result;
+        (*Op->GetConcFunctor())(FoldArgValues.data(), &Result);
+        // Left for the evaluators to report on each point
+        if (ConcreteException || ConcreteOverflow) {
+            ConcreteException = false;
+            ConcreteOverflow = false;
+            return nullptr;
+        }
+        auto Value = Solver->CreateValue(Op->GetEvalType(), Result.GetValue());
+        return Solver->CreateConstant(Value);
+    }
+
+    inline bool CFGEnumeratorSingle::IsConstDuplicate(const GrammarNode* GN,
+                                                      const ConcreteValueBase* Value,
+                                                      uint32 Cost)
+    {
+        auto Home = ConstHomes.find(GN);
+        if (Home == ConstHomes.end()) {
+            return false;
+        }
+        auto& Costs = ConstCosts[Home->second];
+        auto it = Costs.find(Value);
+        if (it == Costs.end()) {
+            Costs[Value] = Cost;
+            return false;
+        } else if (it->second <= Cost) {
+            return true;
+        } else {
+            it->second = Cost;
+            return false;
         }
     }
 
-    GenExpTLVec*
+    const ExpBankEntry*
     CFGEnumeratorSingle::PopulateExpsOfGNCost(const GrammarNode* GN, uint32 Cost, bool Complete)
     {
-        auto Retval = new GenExpTLVec();
         GNCostPair Key(GN, Cost);
         Done = false;
         auto Type = GN->GetType();
@@ -134,51 +298,69 @@ namespace ESolver {
         auto FPVar = GN->As<GrammarFPVar>();
         // The base cases
         if (FPVar != nullptr) {
-            return MakeBaseExpression<GenFPExpression>(Retval, FPVar->GetOp(), Type,
+            return MakeBaseExpression<GenFPExpression>(FPVar->GetOp(), Type,
                                                        ExpansionTypeID, Cost, Key, Complete);
         }
 
         auto LetVar = GN->As<GrammarLetVar>();
         if (LetVar != nullptr) {
-            return MakeBaseExpression<GenLetVarExpression>(Retval, LetVar->GetOp(), Type,
+            return MakeBaseExpression<GenLetVarExpression>(LetVar->GetOp(), Type,
                                                            ExpansionTypeID, Cost, Key, Complete);
         }
 
         auto Const = GN->As<GrammarConst>();
         if (Const != nullptr) {
-            return MakeBaseExpression<GenConstExpression>(Retval, Const->GetOp(), Type,
+            return MakeBaseExpression<GenConstExpression>(Const->GetOp(), Type,
                                                           ExpansionTypeID, Cost, Key, Complete);
         }
 
+        auto Hole = GN->As<GrammarConstHole>();
+        if (Hole != nullptr) {
+            return MakeBaseExpression<GenConstHoleExpression>(Hole->GetOp(), Type,
+                                                              ExpansionTypeID, Cost, Key, Complete);
+        }
+
         auto Func = GN->As<GrammarFunc>();
 
         if (Func != nullptr) {
             auto const& Args = Func->GetChildren();
             auto Op = Func->GetOp();
+            auto FuncOp = static_cast<const InterpretedFuncOperator*>(Op);
             const uint32 OpCost = Op->GetCost();
             const uint32 Arity = Op->GetArity();
+            const bool HasFacts = (FuncHomes.find(Func) != FuncHomes.end());
+            const bool IsAffine = (AffineHomes.find(Func) != AffineHomes.end());
+            const bool MayBeGround = (GroundFuncs.find(Func) != GroundFuncs.end());
+            auto Frame = Bank.OpenExps();
 
             if (Cost < Arity + OpCost) {
-                Retval->Freeze();
-                ExpRepository[Key] = Retval;
+                auto Retval = &(ExpRepository[Key] = Bank.CloseExps(Frame));
                 PopExpansion();
                 return Retval;
             }
-            PartitionGenerator* PG;
+            const PartitionGenerator* PG;
             if (Op->IsSymmetric() && Args[0] == Args[1]) {
-                PG = new SymPartitionGenerator(Cost - OpCost);
+                PG = SymPartitionGenerator::Get(Cost - OpCost);
             } else {
-                PG = new PartitionGenerator(Cost - OpCost, Arity);
+                PG = PartitionGenerator::Get(Cost - OpCost, Arity);
             }
 
             const uint32 NumPartitions = PG->Size();
+            vector<ExpBankEntry> ArgEntries(Arity);
             for (uint32 i = 0; i < NumPartitions; ++i) {
 
                 auto Feasible = true;
-                vector<const GenExpTLVec*> ArgExpVecs(Arity, nullptr);
-                auto CurPartition = (*PG)[i];
-                vector<GenExpTLVec::ConstIterator> Begins(Arity);
-                vector<GenExpTLVec::ConstIterator> Ends(Arity);
+                auto const& CurPartition = (*PG)[i];
+
+                for (uint32 j = 0; j < Arity; ++j) {
+                    if (IsKnownEmpty(Args[j], CurPartition[j])) {
+                        Feasible = false;
+                        break;
+                    }
+                }
+                if (!Feasible) {
+                    continue;
+                }
 
                 for (uint32 j = 0; j < Arity; ++j) {
                     auto CurVec = GetVecForGNCost(Args[j], CurPartition[j]);
@@ -189,9 +371,7 @@ namespace ESolver {
                         Feasible = false;
                         break;
                     } else {
-                        ArgExpVecs[j] = CurVec;
-                        Begins[j] = CurVec->Begin();
-                        Ends[j] = CurVec->End();
+                        ArgEntries[j] = *CurVec;
                     }
                 }
 
@@ -200,41 +380,63 @@ namespace ESolver {
                 }
 
                 // Iterate over the cross product
-                auto CPGen = new CrossProductGenerator(Begins, Ends, GetPoolForSize(Arity));
-
-                for (auto CurArgs = CPGen->GetNext();
-                     CurArgs != nullptr;
-                     CurArgs = CPGen->GetNext()) {
-
-                    auto CurExp = new (FuncExpPool->malloc())
-                        GenFuncExpression(static_cast<const InterpretedFuncOperator*>(Op), CurArgs);
-
-                    auto Status =
-                        (Complete ?
-                         Solver->ExpressionCallBack(CurExp, Type, ExpansionTypeID, Index) :
-                         Solver->SubExpressionCallBack(CurExp, Type, ExpansionTypeID));
-
-                    if ((Status & DELETE_EXPRESSION) == 0) {
-                        CPGen->RelinquishOwnerShip();
-                        Retval->PushBack(CurExp);
-                        NumExpsCached++;
-                    } else {
-                        FuncExpPool->free(CurExp);
-                    }
-                    if ((Status & STOP_ENUMERATION) != 0) {
-                        Done = true;
-                        break;
+                CPGen.Initialize(&Bank, ArgEntries);
+
+                for (auto TileSize = CPGen.GetNextTile(); TileSize > 0 && !Done;
+                     TileSize = CPGen.GetNextTile()) {
+                    for (uint32 t = 0; t < TileSize; ++t) {
+                        auto CurArgs = CPGen.GetTuple(t);
+
+                        // Skipped before anything is evaluated
+                        if (HasFacts && IsNonCanonical(Func, FuncOp, CurArgs)) {
+                            continue;
+                        }
+                        bool HasForm = false;
+                        if (IsAffine &&
+                            IsAffineDuplicate(Func, FuncOp, CurArgs, Cost, HasForm)) {
+                            continue;
+                        }
+                        const ConstOperator* CurConst = nullptr;
+                        if (MayBeGround) {
+                            CurConst = FoldGround(FuncOp, CurArgs);
+                            if (CurConst != nullptr &&
+                                IsConstDuplicate(Func, CurConst->GetConstantValue(), Cost)) {
+                                continue;
+                            }
+                        }
+
+                        auto CurExp = new (FuncExpArena.Allocate(GenFuncExpression::GetSize(Arity)))
+                            GenFuncExpression(FuncOp, CurArgs);
+
+                        auto Status =
+                            (Complete ?
+                             Solver->ExpressionCallBack(CurExp, Type, ExpansionTypeID, Index) :
+                             Solver->SubExpressionCallBack(CurExp, Type, ExpansionTypeID, Index));
+
+                        if ((Status & DELETE_EXPRESSION) == 0) {
+                            Bank.PushBack(CurExp);
+                            NumExpsCached++;
+                            if (HasForm) {
+                                AffineForms[CurExp] = FormScratch;
+                            }
+                            if (CurConst != nullptr) {
+                                FoldedConsts[CurExp] = CurConst;
+                            }
+                        } else {
+                            FuncExpArena.FreeLast(CurExp);
+                        }
+                        if ((Status & STOP_ENUMERATION) != 0) {
+                            Done = true;
+                            break;
+                        }
                     }
                 }
-                delete CPGen;
                 if (Done) {
                     break;
                 }
             }
-            delete PG;
 
-            Retval->Freeze();
-            ExpRepository[Key] = Retval;
+            auto Retval = &(ExpRepository[Key] = Bank.CloseExps(Frame));
             PopExpansion();
             return Retval;
         }
@@ -248,25 +450,34 @@ namespace ESolver {
             const uint32 Arity = NumBindings + 1;
             auto BoundNode = Let->GetBoundExpression();
             const uint32 NumLetBoundVars = TheGrammar->GetNumLetBoundVars();
+            auto Frame = Bank.OpenExps();
 
             if (Cost < Arity + 1) {
-                Retval->Freeze();
-                ExpRepository[Key] = Retval;
+                auto Retval = &(ExpRepository[Key] = Bank.CloseExps(Frame));
                 PopExpansion();
                 return Retval;
             }
 
             // Making a let binding incurs a cost of 1!
-            auto PG = new PartitionGenerator(Cost - 1, Arity);
+            auto PG = PartitionGenerator::Get(Cost - 1, Arity);
             const uint32 NumPartitions = PG->Size();
+            vector<ExpBankEntry> ArgEntries(Arity);
             for (uint32 i = 0; i < NumPartitions; ++i) {
                 auto Feasible = true;
-                vector<const GenExpTLVec*> ArgExpVecs(Arity, nullptr);
-                auto CurPartition = (*PG)[i];
-                vector<GenExpTLVec::ConstIterator> Begins(Arity);
-                vector<GenExpTLVec::ConstIterator> Ends(Arity);
+                auto const& CurPartition = (*PG)[i];
 
                 uint32 j = 0;
+                for (auto it = Bindings.begin(); it != Bindings.end(); ++it) {
+                    if (IsKnownEmpty(it->second, CurPartition[j++])) {
+                        Feasible = false;
+                        break;
+                    }
+                }
+                if (!Feasible || IsKnownEmpty(BoundNode, CurPartition[NumBindings])) {
+                    continue;
+                }
+
+                j = 0;
                 uint32* Positions = new uint32[NumBindings];
 
                 for (auto it = Bindings.begin(); it != Bindings.end(); ++it) {
@@ -278,9 +489,7 @@ namespace ESolver {
                         Feasible = false;
                         break;
                     } else {
-                        ArgExpVecs[j] = CurVec;
-                        Begins[j] = CurVec->Begin();
-                        Ends[j] = CurVec->End();
+                        ArgEntries[j] = *CurVec;
                     }
                     Positions[j] = it->first->GetOp()->GetPosition();
                     ++j;
@@ -301,51 +510,51 @@ namespace ESolver {
                     delete[] Positions;
                     continue;
                 } else {
-                    ArgExpVecs[NumBindings] = BoundVec;
-                    Begins[NumBindings] = BoundVec->Begin();
-                    Ends[NumBindings] = BoundVec->End();
+                    ArgEntries[NumBindings] = *BoundVec;
                 }
 
 
                 // Iterate over the cross product of expressions
                 // The bindings object will be of size of the NUMBER
                 // of let bound vars for the whole grammar
-                auto CPGen = new CrossProductGenerator(Begins, Ends,
-                                                       GetPoolForSize(Arity));
+                CPGen.Initialize(&Bank, ArgEntries);
                 GenExpressionBase const** BindVec = nullptr;
-                auto BindVecPool = GetPoolForSize(NumLetBoundVars);
-
-                for (auto CurArgs = CPGen->GetNext(); CurArgs != nullptr; CurArgs = CPGen->GetNext()) {
-                    // We need to build the binding vector based on the position
-                    if (BindVec == nullptr) {
-                        BindVec = (GenExpressionBase const**)BindVecPool->malloc();
-                        memset(BindVec, 0, sizeof(GenExpressionBase const*) * NumLetBoundVars);
-                    }
-                    for (uint32 k = 0; k < NumBindings; ++k) {
-                        BindVec[Positions[k]] = CurArgs[k];
-                    }
-
-                    auto CurExp = new (LetExpPool->malloc())
-                        GenLetExpression(BindVec, CurArgs[NumBindings], NumLetBoundVars);
-                    auto Status =
-                        (Complete ?
-                         Solver->ExpressionCallBack(CurExp, Type, ExpansionTypeID, Index) :
-                         Solver->SubExpressionCallBack(CurExp, Type, ExpansionTypeID));
-
-                    if ((Status & DELETE_EXPRESSION) == 0) {
-                        BindVec = nullptr;
-                        Retval->PushBack(CurExp);
-                        NumExpsCached++;
-                    } else {
-                        LetExpPool->free(CurExp);
-                    }
-                    if ((Status & STOP_ENUMERATION) != 0) {
-                        Done = true;
-                        break;
+                const uint64 BindVecSize = sizeof(GenExpressionBase const*) * NumLetBoundVars;
+
+                for (auto TileSize = CPGen.GetNextTile(); TileSize > 0 && !Done;
+                     TileSize = CPGen.GetNextTile()) {
+                    for (uint32 t = 0; t < TileSize; ++t) {
+                        auto CurArgs = CPGen.GetTuple(t);
+                        // We need to build the binding vector based on the position
+                        if (BindVec == nullptr) {
+                            BindVec = (GenExpressionBase const**)LetExpArena.Allocate(BindVecSize);
+                            memset(BindVec, 0, BindVecSize);
+                        }
+                        for (uint32 k = 0; k < NumBindings; ++k) {
+                            BindVec[Positions[k]] = CurArgs[k];
+                        }
+
+                        auto CurExp = new (LetExpArena.Allocate(sizeof(GenLetExpression)))
+                            GenLetExpression(BindVec, CurArgs[NumBindings], NumLetBoundVars);
+                        auto Status =
+                            (Complete ?
+                             Solver->ExpressionCallBack(CurExp, Type, ExpansionTypeID, Index) :
+                             Solver->SubExpressionCallBack(CurExp, Type, ExpansionTypeID, Index));
+
+                        if ((Status & DELETE_EXPRESSION) == 0) {
+                            BindVec = nullptr;
+                            Bank.PushBack(CurExp);
+                            NumExpsCached++;
+                        } else {
+                            LetExpArena.FreeLast(CurExp);
+                        }
+                        if ((Status & STOP_ENUMERATION) != 0) {
+                            Done = true;
+                            break;
+                        }
                     }
                 }
 
-                delete CPGen;
                 delete[] Positions;
 
                 if (Done) {
@@ -353,10 +562,7 @@ namespace ESolver {
                 }
             }
 
-            delete PG;
-
-            Retval->Freeze();
-            ExpRepository[Key] = Retval;
+            auto Retval = &(ExpRepository[Key] = Bank.CloseExps(Frame));
             PopExpansion();
             return Retval;
         }
@@ -364,18 +570,18 @@ namespace ESolver {
         auto NT = GN->As<GrammarNonTerminal>();
         if (NT != nullptr) {
             const vector<GrammarNode*>& Expansions = TheGrammar->GetExpansions(NT);
+            auto Frame = Bank.OpenSpans();
             for (auto const& Expansion : Expansions) {
                 auto CurVec = GetVecForGNCost(Expansion, Cost);
                 if (CurVec == nullptr) {
                     CurVec = PopulateExpsOfGNCost(Expansion, Cost, Complete);
                 }
-                Retval->Merge(*CurVec);
+                Bank.Merge(*CurVec);
                 if (Done) {
                     break;
                 }
             }
-            Retval->Freeze();
-            ExpRepository[Key] = Retval;
+            auto Retval = &(ExpRepository[Key] = Bank.CloseSpans(Frame));
             PopExpansion();
             return Retval;
         }
@@ -392,27 +598,168 @@ namespace ESolver {
         : EnumeratorBase(Solver), TheGrammar(InputGrammar),
           Index(Index), NumExpsCached((uint64)0)
     {
-        FuncExpPool = new boost::pool<>(sizeof(GenFuncExpression));
-        LetExpPool = new boost::pool<>(sizeof(GenLetExpression));
+
+        // Find the function nodes that rewrite facts apply to
+        for (auto const& NT : TheGrammar->GetNonTerminals()) {
+            map<const FuncOperatorBase*, uint32> NumExpansionsWithOp;
+            for (auto const& Expansion : TheGrammar->GetExpansions(NT)) {
+                auto Func = Expansion->As<GrammarFunc>();
+                if (Func != nullptr) {
+                    ++NumExpansionsWithOp[Func->GetOp()];
+                }
+            }
+            for (auto const& Expansion : TheGrammar->GetExpansions(NT)) {
+                auto Func = Expansion->As<GrammarFunc>();
+                if (Func == nullptr) {
+                    continue;
+                }
+                auto it = FuncHomes.find(Func);
+                if (it != FuncHomes.end()) {
+                    it->second.first = nullptr;
+                    continue;
+                }
+                auto FuncOp = OperatorBase::As<InterpretedFuncOperator>(Func->GetOp());
+                if (FuncOp == nullptr) {
+                    continue;
+                }
+                auto const& Facts = FuncOp->GetRewriteFacts();
+                if (Facts.LeftIdentity == nullptr && Facts.RightIdentity == nullptr &&
+                    Facts.LeftAnnihilator == nullptr && Facts.RightAnnihilator == nullptr &&
+                    !Facts.Idempotent && !Facts.Involutive && !Facts.Associative) {
+                    continue;
+                }
+                FuncHomes[Func] = make_pair(NT, NumExpansionsWithOp[Func->GetOp()] == 1);
+            }
+        }
+
+        // Find the integer nodes that have affine forms
+        unordered_set<const GrammarNode*> SharedNodes;
+        for (auto const& NT : TheGrammar->GetNonTerminals()) {
+            if (NT->GetType()->GetBaseType() != BaseTypeInt) {
+                continue;
+            }
+            for (auto const& Expansion : TheGrammar->GetExpansions(NT)) {
+                if (SharedNodes.find(Expansion) != SharedNodes.end()) {
+                    continue;
+                }
+                if (AffineHomes.find(Expansion) != AffineHomes.end()) {
+                    AffineHomes.erase(Expansion);
+                    SharedNodes.insert(Expansion);
+                    continue;
+                }
+                auto Func = Expansion->As<GrammarFunc>();
+                if (Func != nullptr) {
+                    auto const& Name = Func->GetOp()->GetName();
+                    if (OperatorBase::As<InterpretedFuncOperator>(Func->GetOp()) == nullptr ||
+                        (Name != "+" && Name != "-" && Name != "*")) {
+                        continue;
+                    }
+                } else if (Expansion->As<GrammarFPVar>() == nullptr &&
+                           Expansion->As<GrammarConst>() == nullptr) {
+                    continue;
+                }
+                AffineHomes[Expansion] = NT;
+            }
+        }
+
+        // Find the nodes that derive ground terms, up to a fixpoint
+        unordered_set<const GrammarNode*> GroundNodes;
+        bool Changed = true;
+        while (Changed) {
+            Changed = false;
+            for (auto const& NT : TheGrammar->GetNonTerminals()) {
+                for (auto const& Expansion : TheGrammar->GetExpansions(NT)) {
+                    if (GroundNodes.find(Expansion) != GroundNodes.end()) {
+                        continue;
+                    }
+                    auto Ground = (Expansion->As<GrammarConst>() != nullptr);
+                    auto Func = Expansion->As<GrammarFunc>();
+                    if (Func != nullptr &&
+                        OperatorBase::As<InterpretedFuncOperator>(Func->GetOp()) != nullptr) {
+                        Ground = true;
+                        for (auto const& Child : Func->GetChildren()) {
+                            if (Child->As<GrammarConst>() == nullptr &&
+                                GroundNodes.find(Child) == GroundNodes.end()) {
+                                Ground = false;
+                                break;
+                            }
+                        }
+                        if (Ground) {
+                            GroundFuncs.insert(Func);
+                        }
+                    }
+                    if (Ground) {
+                        GroundNodes.insert(Expansion);
+                        GroundNodes.insert(NT);
+                        Changed = true;
+                    }
+                }
+            }
+        }
+
+        SharedNodes.clear();
+        for (auto const& NT : TheGrammar->GetNonTerminals()) {
+            for (auto const& Expansion : TheGrammar->GetExpansions(NT)) {
+                if (GroundNodes.find(Expansion) == GroundNodes.end() ||
+                    SharedNodes.find(Expansion) != SharedNodes.end()) {
+                    continue;
+                }
+                if (ConstHomes.find(Expansion) != ConstHomes.end()) {
+                    ConstHomes.erase(Expansion);
+                    SharedNodes.insert(Expansion);
+                    continue;
+                }
+                ConstHomes[Expansion] = NT;
+            }
+        }
+
+        // The least cost of the terms of each non-terminal and each
+        // expansion, up to a fixpoint. Non-terminals that derive no
+        // terms at all are left at UINT32_MAX
+        for (auto const& NT : TheGrammar->GetNonTerminals()) {
+            MinCosts[NT] = UINT32_MAX;
+        }
+        Changed = true;
+        while (Changed) {
+            Changed = false;
+            for (auto const& NT : TheGrammar->GetNonTerminals()) {
+                uint32 NTMinCost = MinCosts[NT];
+                for (auto const& Expansion : TheGrammar->GetExpansions(NT)) {
+                    uint64 CurMinCost = 1;
+                    auto Func = Expansion->As<GrammarFunc>();
+                    auto Let = Expansion->As<GrammarLet>();
+                    if (Func != nullptr) {
+                        CurMinCost = Func->GetOp()->GetCost();
+                        for (auto const& Child : Func->GetChildren()) {
+                            CurMinCost += GetMinCost(Child);
+                        }
+                    } else if (Let != nullptr) {
+                        CurMinCost += GetMinCost(Let->GetBoundExpression());
+                        for (auto const& Binding : Let->GetBindings()) {
+                            CurMinCost += GetMinCost(Binding.second);
+                        }
+                    }
+                    CurMinCost = min(CurMinCost, (uint64)UINT32_MAX);
+                    MinCosts[Expansion] = CurMinCost;
+                    if (CurMinCost < NTMinCost) {
+                        NTMinCost = CurMinCost;
+                        Changed = true;
+                    }
+                }
+                MinCosts[NT] = NTMinCost;
+            }
+        }
     }
 
     CFGEnumeratorSingle::~CFGEnumeratorSingle()
     {
         // We just delete the expressions that we're managing
-        // the pools will take care of the rest
+        // the arenas will take care of the rest
         for (auto const& Exp : ExpsToDelete) {
             delete Exp;
         }
         ExpsToDelete.clear();
-        delete FuncExpPool;
-        delete LetExpPool;
-        for (auto const& KV : CPPools) {
-            delete KV.second;
-        }
-        CPPools.clear();
-        for (auto const& KV : ExpRepository) {
-            delete KV.second;
-        }
+        Bank.Clear();
         ExpRepository.clear();
     }
 
@@ -422,12 +769,13 @@ namespace ESolver {
         auto Vec = GetVecForGNCost(StartNT, Cost);
         if (Vec != nullptr) {
             auto Type = StartNT->GetType();
-            auto const Begin = Vec->Begin();
-            auto const End = Vec->End();
-            for (auto it = Begin; it != End; ++it) {
-                // If we're being recalled to enumerate,
-                // then there's no need for an expansion type id
-                Solver->ExpressionCallBack(*it, Type, 0, Index);
+            auto const Spans = Bank.GetSpans(*Vec);
+            for (uint32 i = 0; i < Vec->NumSpans; ++i) {
+                for (uint32 ID = Spans[i].Begin; ID < Spans[i].End; ++ID) {
+                    // If we're being recalled to enumerate,
+                    // then there's no need for an expansion type id
+                    Solver->ExpressionCallBack(Bank.Get(ID), Type, 0, Index);
+                }
             }
         } else {
             PopulateExpsOfGNCost(StartNT, Cost, true);
@@ -440,25 +788,42 @@ namespace ESolver {
             delete Exp;
         }
         ExpsToDelete.clear();
-        delete FuncExpPool;
-        delete LetExpPool;
-        for (auto const& KV : CPPools) {
-            delete KV.second;
-        }
-        CPPools.clear();
+        FuncExpArena.Clear();
+        LetExpArena.Clear();
 
         // Clear all the built up state
-        for (auto const& KV : ExpRepository) {
-            delete KV.second;
-        }
+        Bank.Clear();
         ExpRepository.clear();
+        AffineFormCosts.clear();
+        AffineForms.clear();
+        ConstCosts.clear();
+        FoldedConsts.clear();
         ExpansionTypeUIDGenerator.Reset();
         ExpansionStack.clear();
         ExpansionToTypeID.clear();
+    }
 
-        // Recreate basic pool types
-        FuncExpPool = new boost::pool<>(sizeof(GenFuncExpression));
-        LetExpPool = new boost::pool<>(sizeof(GenLetExpression));
+    void CFGEnumeratorSingle::GetMemoryBreakdown(MemoryBreakdown& Breakdown) const
+    {
+        Breakdown.Add("Enumerator.FuncExpArenaBytes", FuncExpArena.GetBytesAllocated());
+        Breakdown.Add("Enumerator.LetExpArenaBytes", LetExpArena.GetBytesAllocated());
+        Breakdown.Add("Enumerator.NumBaseExps", ExpsToDelete.size());
+        Breakdown.Add("Enumerator.BankExpBytes", Bank.GetNumExps() * sizeof(GenExpressionBase const*));
+        Breakdown.Add("Enumerator.BankSpanBytes", Bank.GetNumSpans() * sizeof(ExpIdSpan));
+        Breakdown.Add("Enumerator.NumRepositoryEntries", ExpRepository.size());
+
+        // Expressions cached at each cost. Those of a non-terminal are
+        // also counted in the entries of its expansions, so only the
+        // entries of function, let and leaf nodes are summed up
+        map<uint32, uint64> ExpsOfCost;
+        for (auto const& KV : ExpRepository) {
+            if (KV.first.GetNode()->As<GrammarNonTerminal>() == nullptr) {
+                ExpsOfCost[KV.first.GetCost()] += KV.second.NumExps;
+            }
+        }
+        for (auto const& KV : ExpsOfCost) {
+            Breakdown.Add("Enumerator.NumExpsOfCost." + to_string(KV.first), KV.second);
+        }
     }
 
     uint32 CFGEnumeratorSingle::GetIndex() const
@@ -470,9 +835,12 @@ namespace ESolver {
     CFGEnumeratorMulti::ESolverMultiStub::ESolverMultiStub(ESolverOpts* Opts,
                                                            ESolver* Solver,
                                                            const vector<CFGEnumeratorSingle*>& Enumerators,
-                                                           const vector<const ESFixedTypeBase*>& TargetTypes)
+                                                           const vector<const ESFixedTypeBase*>& TargetTypes,
+                                                           bool Separable)
         : ESolver(Opts), Solver(Solver), Enumerators(Enumerators),
-          TargetTypes(TargetTypes), NumExpressions(Enumerators.size())
+          TargetTypes(TargetTypes), NumExpressions(Enumerators.size()),
+          Separable(Separable), ComponentDone(Enumerators.size(), false),
+          StopPending(false)
     {
         ExpVec = (GenExpressionBase const**)calloc(NumExpressions, sizeof(GenExpressionBase const*));
         TypeVec = (ESFixedTypeBase const**)calloc(NumExpressions, sizeof(ESFixedTypeBase const*));
@@ -496,6 +864,34 @@ namespace ESolver {
                                                              uint32 ExpansionTypeID,
                                                              uint32 EnumeratorIndex)
     {
+        if (Separable) {
+            // Each component is checked on its own by the solver
+            auto Status = Solver->ExpressionCallBack(Exp, Type, ExpansionTypeID, EnumeratorIndex);
+            if ((Status & RESTART_ENUMERATION) != 0) {
+                StopPending = true;
+            } else if ((Status & STOP_ENUMERATION) != 0) {
+                ComponentDone[EnumeratorIndex] = true;
+            }
+            return Status;
+        }
+
+        if (StopPending) {
+            return STOP_ENUMERATION;
+        }
+
+        // An expansion type id of zero means that the enumerator is
+        // replaying its cache, these expressions have been checked already.
+        // Otherwise, drop the expression if it is indistinguishable from
+        // one we've already seen for the same function: every tuple it
+        // would be part of is then indistinguishable as well
+        if (ExpansionTypeID != 0) {
+            auto DistStatus = Solver->SubExpressionCallBack(Exp, Type, ExpansionTypeID,
+                                                            EnumeratorIndex);
+            if ((DistStatus & DELETE_EXPRESSION) != 0) {
+                return DELETE_EXPRESSION;
+            }
+        }
+
         ExpVec[EnumeratorIndex] = Exp;
         TypeVec[EnumeratorIndex] = Type;
         ExpansionTypeIDVec[EnumeratorIndex] = ExpansionTypeID;
@@ -504,19 +900,24 @@ namespace ESolver {
             // We've run out of expressions at the lower levels
             // Enumerate from the next higher level
             Enumerators[EnumeratorIndex + 1]->EnumerateOfCost(CurrentSizes[EnumeratorIndex + 1]);
-            return NONE_STATUS;
+            return (StopPending ? STOP_ENUMERATION : NONE_STATUS);
         } else {
             // We have a complete ExpVec
-            return Solver->ExpressionCallBack(ExpVec, TypeVec, ExpansionTypeIDVec);
+            auto Status = Solver->ExpressionCallBack(ExpVec, TypeVec, ExpansionTypeIDVec);
+            if ((Status & STOP_ENUMERATION) != 0) {
+                StopPending = true;
+            }
+            return Status;
         }
     }
 
     CallbackStatus
     CFGEnumeratorMulti::ESolverMultiStub::SubExpressionCallBack(const GenExpressionBase *Exp,
                                                                 const ESFixedTypeBase *Type,
-                                                                uint32 ExpansionTypeID)
+                                                                uint32 ExpansionTypeID,
+                                                                uint32 EnumeratorIndex)
     {
-        return Solver->SubExpressionCallBack(Exp, Type, ExpansionTypeID);
+        return Solver->SubExpressionCallBack(Exp, Type, ExpansionTypeID, EnumeratorIndex);
     }
 
 
@@ -548,6 +949,29 @@ namespace ESolver {
         Enumerators[0]->EnumerateOfCost(Sizes[0]);
     }
 
+    void CFGEnumeratorMulti::ESolverMultiStub::EnumerateComponentsOfCost(uint32 Size)
+    {
+        // Only the components which are yet to be settled
+        // need expressions of this size
+        for (uint32 i = 0; i < NumExpressions && !StopPending; ++i) {
+            if (ComponentDone[i]) {
+                continue;
+            }
+            Enumerators[i]->EnumerateOfCost(Size);
+        }
+    }
+
+    void CFGEnumeratorMulti::ESolverMultiStub::ResetComponents()
+    {
+        ComponentDone.assign(NumExpressions, false);
+        StopPending = false;
+    }
+
+    bool CFGEnumeratorMulti::ESolverMultiStub::IsStopPending() const
+    {
+        return StopPending;
+    }
+
     void CFGEnumeratorMulti::ESolverMultiStub::SetEnumerator(uint32 Index,
                                                               CFGEnumeratorSingle* Enumerator)
     {
@@ -556,13 +980,14 @@ namespace ESolver {
 
 
     // CFGEnumeratorMulti implementation
-    CFGEnumeratorMulti::CFGEnumeratorMulti(ESolver* Solver, const vector<Grammar*>& InputGrammars)
+    CFGEnumeratorMulti::CFGEnumeratorMulti(ESolver* Solver, const vector<Grammar*>& InputGrammars,
+                                           bool Separable)
         : EnumeratorBase(Solver), Enumerators(InputGrammars.size(), nullptr),
-          TargetTypes(InputGrammars.size(), nullptr)
+          TargetTypes(InputGrammars.size(), nullptr), Separable(Separable)
     {
         ESolverOpts Opts;
         const uint32 NumGrammars = InputGrammars.size();
-        Stub = new ESolverMultiStub(&Opts, Solver, Enumerators, TargetTypes);
+        Stub = new ESolverMultiStub(&Opts, Solver, Enumerators, TargetTypes, Separable);
 
         for (uint32 i = 0; i < NumGrammars; ++i) {
             Enumerators[i] = new CFGEnumeratorSingle(Stub, InputGrammars[i], i);
@@ -581,26 +1006,41 @@ namespace ESolver {
 
     void CFGEnumeratorMulti::EnumerateOfCost(uint32 Size)
     {
+        // Separable specs: the size is per function, and each
+        // function is enumerated independently of the others
+        if (Separable) {
+            Stub->EnumerateComponentsOfCost(Size);
+            return;
+        }
+
         const uint32 NumEnumerators = Enumerators.size();
         // We enumerate over all partitions of the size
         if (Size < NumEnumerators) {
             return;
         }
-        auto PG = new PartitionGenerator(Size, NumEnumerators);
+        auto PG = PartitionGenerator::Get(Size, NumEnumerators);
         const uint32 NumPartitions = PG->Size();
-        for (uint32 i = 0; i < NumPartitions; ++i) {
-            auto CurPart = (*PG)[i];
+        for (uint32 i = 0; i < NumPartitions && !Stub->IsStopPending(); ++i) {
+            auto const& CurPart = (*PG)[i];
             Stub->EnumerateOfCosts(CurPart);
         }
     }
 
     void CFGEnumeratorMulti::OnReset()
     {
+        Stub->ResetComponents();
         for (auto const& Enumerator : Enumerators) {
             Enumerator->Reset();
         }
     }
 
+    void CFGEnumeratorMulti::GetMemoryBreakdown(MemoryBreakdown& Breakdown) const
+    {
+        for (auto const& Enumerator : Enumerators) {
+            Enumerator->GetMemoryBreakdown(Breakdown);
+        }
+    }
+
 } /* End namespace */
 
 //
@@ -45,20 +45,23 @@
 #include "../utils/Hashers.hpp"
 #include "../utils/GNCostPair.hpp"
 #include "../expressions/GenExpression.hpp"
-#include "../containers/TwoLevelVec.hpp"
+#include "../containers/ExpressionBank.hpp"
+#include "../containers/BumpArena.hpp"
+#include "../partitions/CrossProductGenerator.hpp"
+#include "../logics/LIAAffineForm.hpp"
 #include "../solvers/ESolver.hpp"
-#include <boost/pool/pool.hpp>
 
 namespace ESolver {
 
     // Some typedefs to avoid long template instantiations
-    typedef unordered_map<GNCostPair, GenExpTLVec*,
+    typedef unordered_map<GNCostPair, ExpBankEntry,
                           GNCostPairHasher, GNCostPairEquals> ExpsOfGNCost;
 
     class CFGEnumeratorSingle : public EnumeratorBase
     {
     private:
         const Grammar* TheGrammar;
+        ExpressionBank Bank;
         ExpsOfGNCost ExpRepository;
         vector<string> ExpansionStack;
         unordered_map<string, uint32> ExpansionToTypeID;
@@ -68,59 +71,140 @@ namespace ESolver {
         uint32 Index;
         uint64 NumExpsCached;
 
-        // memory pools for fast allocation/deallocation
-        // We use the type unsafe versions here :-( for speed
-        boost::pool<>* FuncExpPool;
-        boost::pool<>* LetExpPool;
-        unordered_map<uint32, boost::pool<>*> CPPools;
+        // The non-terminal that each function node of the grammar is
+        // an expansion of, or nullptr if it is an expansion of several.
+        // The flag tells if it is the only expansion of the non-terminal
+        // with its operator. A rewrite fact can only be used to skip a
+        // candidate when the equal candidate is an expansion of the
+        // same non-terminal
+        unordered_map<const GrammarFunc*, pair<const GrammarNonTerminal*, bool>> FuncHomes;
 
-        // Utility functions
-        inline boost::pool<>* GetPoolForSize(uint32 Size);
+        // The non-terminal of each integer node whose terms have an
+        // affine form: parameters, constants, and applications of +, -
+        // and *. Only nodes that are expansions of a single non-terminal
+        // are present. A candidate is skipped when a term with the same
+        // form and no larger cost has already been enumerated for the
+        // same non-terminal
+        unordered_map<const GrammarNode*, const GrammarNonTerminal*> AffineHomes;
+        unordered_map<const GrammarNonTerminal*,
+                      unordered_map<LIAAffineForm, uint32, LIAAffineFormHasher>> AffineFormCosts;
+        // Forms of the cached affine function terms. Parameters,
+        // constants and the other cached terms, which are atoms in the
+        // forms of their parents, get theirs the first time they are used
+        unordered_map<const GenExpressionBase*, LIAAffineForm> AffineForms;
+        // Reused across candidates, so that forms are only copied
+        // for the candidates that are kept
+        vector<const LIAAffineForm*> ArgFormScratch;
+        LIAAffineForm FormScratch;
+
+        // Function nodes whose terms may be ground, because each of their
+        // arguments derives a term built from constants only. Ground terms
+        // are evaluated once, when they are built, and identified by their
+        // value as a constant from the ConstManager. A ground candidate is
+        // skipped when a term with the same value and no larger cost has
+        // already been enumerated for the same non-terminal, ConstHomes
+        // has the non-terminal of each such node and of each constant
+        unordered_set<const GrammarFunc*> GroundFuncs;
+        unordered_map<const GrammarNode*, const GrammarNonTerminal*> ConstHomes;
+        unordered_map<const GrammarNonTerminal*,
+                      unordered_map<const ConcreteValueBase*, uint32,
+                                    ConcreteValueBasePtrHasher,
+                                    ConcreteValueBasePtrEquals>> ConstCosts;
+        // The constants of the cached ground function terms
+        unordered_map<const GenExpressionBase*, const ConstOperator*> FoldedConsts;
+        vector<const ConcreteValueBase*> FoldArgValues;
+
+        // Function expressions are stored with their children,
+        // one after the other, in the order they are enumerated
+        BumpArena FuncExpArena;
+        // Shared by all nodes, the arguments of a node are populated
+        // before it generates their cross product
+        CrossProductGenerator CPGen;
+        // The least cost of the terms of each grammar node. A partition
+        // of the cost of a node among its arguments is skipped, without
+        // populating any of the arguments, when it gives an argument
+        // less than its least cost, or a cost at which the argument is
+        // known to have no terms
+        unordered_map<const GrammarNode*, uint32> MinCosts;
+
+        // Let expressions and their binding vectors, freed all at
+        // once on a reset
+        BumpArena LetExpArena;
 
         template<typename T, typename O>
-        inline GenExpTLVec* MakeBaseExpression(GenExpTLVec* ExpVec,
-                                               const O* Op,
-                                               const ESFixedTypeBase* Type,
-                                               uint32 ExpansionTypeID,
-                                               uint32 Cost,
-                                               const GNCostPair& Key,
-                                               bool Complete)
+        inline const ExpBankEntry* MakeBaseExpression(const O* Op,
+                                                      const ESFixedTypeBase* Type,
+                                                      uint32 ExpansionTypeID,
+                                                      uint32 Cost,
+                                                      const GNCostPair& Key,
+                                                      bool Complete)
         {
+            auto Frame = Bank.OpenExps();
             if (Cost != 1) {
-                ExpRepository[Key] = ExpVec;
-                return ExpVec;
+                return &(ExpRepository[Key] = Bank.CloseExps(Frame));
             }
             auto Exp = new T(Op);
+            auto ConstHome = ConstHomes.find(Key.GetNode());
+            if (ConstHome != ConstHomes.end()) {
+                auto Value = Exp->template As<GenConstExpression>()->GetOp()->GetConstantValue();
+                auto& Costs = ConstCosts[ConstHome->second];
+                auto it = Costs.find(Value);
+                if (it == Costs.end() || it->second > Cost) {
+                    Costs[Value] = Cost;
+                }
+            }
+            auto AffineHome = AffineHomes.find(Key.GetNode());
+            if (AffineHome != AffineHomes.end()) {
+                auto& FormCosts = AffineFormCosts[AffineHome->second];
+                auto const& Form = *GetAffineForm(Exp);
+                auto it = FormCosts.find(Form);
+                if (it == FormCosts.end() || it->second > Cost) {
+                    FormCosts[Form] = Cost;
+                }
+            }
             auto Status =
                 (Complete ?
                  Solver->ExpressionCallBack(Exp, Type, ExpansionTypeID, Index) :
-                 Solver->SubExpressionCallBack(Exp, Type, ExpansionTypeID));
+                 Solver->SubExpressionCallBack(Exp, Type, ExpansionTypeID, Index));
 
             if ((Status & DELETE_EXPRESSION) != 0) {
+                AffineForms.erase(Exp);
                 delete Exp;
             } else {
-                ExpVec->PushBack(Exp);
+                Bank.PushBack(Exp);
                 ExpsToDelete.push_back(Exp);
             }
             if ((Status & STOP_ENUMERATION) != 0) {
                 Done = true;
             }
 
-            ExpVec->Freeze();
-            ExpRepository[Key] = ExpVec;
+            auto Retval = &(ExpRepository[Key] = Bank.CloseExps(Frame));
             PopExpansion();
-            return ExpVec;
+            return Retval;
         }
 
-        inline GenExpTLVec*
+        inline const ExpBankEntry*
         GetVecForGNCost(const GrammarNode* GN, uint32 Cost);
-        inline GenExpTLVec*
-        MakeVecForGNCost(const GrammarNode* GN, uint32 Cost);
+        inline uint32 GetMinCost(const GrammarNode* GN) const;
+        inline bool IsKnownEmpty(const GrammarNode* GN, uint32 Cost);
         inline uint32 GetExpansionTypeID();
         inline void PushExpansion(const string& NTName);
         inline void PopExpansion();
+        inline bool IsNonCanonical(const GrammarFunc* Func,
+                                   const InterpretedFuncOperator* Op,
+                                   GenExpressionBase const* const* Args) const;
+        inline const LIAAffineForm* GetAffineForm(const GenExpressionBase* Exp);
+        inline bool IsAffineDuplicate(const GrammarNode* GN,
+                                      const InterpretedFuncOperator* Op,
+                                      GenExpressionBase const* const* Args,
+                                      uint32 Cost, bool& HasForm);
+        inline const ConstOperator* FoldGround(const InterpretedFuncOperator* Op,
+                                               GenExpressionBase const* const* Args);
+        inline bool IsConstDuplicate(const GrammarNode* GN,
+                                     const ConcreteValueBase* Value,
+                                     uint32 Cost);
 
-        GenExpTLVec*
+        const ExpBankEntry*
         PopulateExpsOfGNCost(const GrammarNode* GN, uint32 Cost, bool Complete);
 
     public:
@@ -129,6 +213,7 @@ namespace ESolver {
 
         virtual void EnumerateOfCost(uint32 Size) override;
         virtual void OnReset() override;
+        virtual void GetMemoryBreakdown(MemoryBreakdown& Breakdown) const override;
         uint32 GetIndex() const;
     };
 
@@ -148,16 +233,27 @@ namespace ESolver {
             uint32* ExpansionTypeIDVec;
             const uint32 NumExpressions;
             vector<uint32> CurrentSizes;
+            // In separable mode, each enumerator is driven on its own
+            // and the solver checks each component independently.
+            // A component is settled when the solver returns
+            // STOP_ENUMERATION for it, until the next reset.
+            const bool Separable;
+            vector<bool> ComponentDone;
+            // Set when the solver asks for the enumeration to
+            // stop from deep within the chain of enumerators
+            bool StopPending;
 
         public:
             ESolverMultiStub(ESolverOpts* Opts, ESolver* Solver,
                              const vector<CFGEnumeratorSingle*>& Enumerators,
-                             const vector<const ESFixedTypeBase*>& TargetTypes);
+                             const vector<const ESFixedTypeBase*>& TargetTypes,
+                             bool Separable);
             virtual ~ESolverMultiStub();
 
             virtual CallbackStatus SubExpressionCallBack(const GenExpressionBase* Exp,
                                                          const ESFixedTypeBase* Type,
-                                                         uint32 ExpansionTypeID) override;
+                                                         uint32 ExpansionTypeID,
+                                                         uint32 EnumeratorIndex = 0) override;
 
             virtual CallbackStatus ExpressionCallBack(const GenExpressionBase* Exp,
                                                       const ESFixedTypeBase* Type,
@@ -174,18 +270,24 @@ namespace ESolver {
 
             void SetEnumerator (uint32 Index, CFGEnumeratorSingle* Enumerator);
             void EnumerateOfCosts(const vector<uint32>& Sizes);
+            void EnumerateComponentsOfCost(uint32 Size);
+            void ResetComponents();
+            bool IsStopPending() const;
         };
 
         vector<CFGEnumeratorSingle*> Enumerators;
         vector<const ESFixedTypeBase*> TargetTypes;
         ESolverMultiStub* Stub;
+        const bool Separable;
 
     public:
-        CFGEnumeratorMulti(ESolver* Solver, const vector<Grammar*>& InputGrammars);
+        CFGEnumeratorMulti(ESolver* Solver, const vector<Grammar*>& InputGrammars,
+                           bool Separable = false);
         virtual ~CFGEnumeratorMulti();
 
         virtual void EnumerateOfCost(uint32 Size) override;
         virtual void OnReset() override;
+        virtual void GetMemoryBreakdown(MemoryBreakdown& Breakdown) const override;
     };
 
 } /* End namespace */
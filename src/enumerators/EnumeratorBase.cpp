@@ -74,6 +74,11 @@ namespace ESolver {
         // want anything special to happen.
     }
 
+    void EnumeratorBase::GetMemoryBreakdown(MemoryBreakdown& Breakdown) const
+    {
+        // Nothing here
+    }
+
 } /* End namespace */
 
 
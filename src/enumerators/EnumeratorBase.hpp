@@ -64,6 +64,9 @@ namespace ESolver {
 
         // Callback for reset event for subclasses
         virtual void OnReset();
+
+        // Adds the sizes of the pools and caches of the enumerator
+        virtual void GetMemoryBreakdown(MemoryBreakdown& Breakdown) const;
     };
 
 } /* End namespace */
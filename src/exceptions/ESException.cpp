@@ -198,12 +198,6 @@ namespace ESolver {
         // Nothing here
     }
 
-    TLVecException::TLVecException(const string& ExceptionInfo)
-        : ESException(ExceptionInfo)
-    {
-        // Nothing here
-    }
-
     ManagedVecException::ManagedVecException(const string& ExceptionInfo)
         : ESException(ExceptionInfo)
     {
@@ -194,12 +194,6 @@ namespace ESolver {
         virtual const char* what() const throw() override;
     };
 
-    class TLVecException : public ESException
-    {
-    public:
-        TLVecException(const string& ExceptionInfo);
-    };
-
     class SpecException : public ESException
     {
     public:
@@ -39,8 +39,12 @@
 
 #include "ExprManager.hpp"
 
+// The smallest table that is collected automatically
+#define ESOLVER_EXPR_MANAGER_MIN_GC_THRESHOLD (1 << 16)
+
 namespace ESolver {
     ExprManager::ExprManager()
+        : GCThreshold(ESOLVER_EXPR_MANAGER_MIN_GC_THRESHOLD)
     {
         // Nothing here
     }
@@ -56,25 +60,74 @@ namespace ESolver {
         if (it != ExpSet.end()) {
             return *it;
         } else {
+            if (ExpSet.size() >= GCThreshold) {
+                GC();
+            }
             ExpSet.insert(Exp);
             return Exp;
         }
     }
-    
+
+    void ExprManager::GatherChildren(const Expression& Exp, vector<Expression>& Children)
+    {
+        auto LetExp = UserExpressionBase::As<UserLetExpression>(Exp.GetPtr());
+        if (LetExp == nullptr) {
+            auto const& ExpChildren = Exp->GetChildren();
+            Children.insert(Children.end(), ExpChildren.begin(), ExpChildren.end());
+            return;
+        }
+        for (auto const& Binding : LetExp->GetLetBoundVars()) {
+            Children.push_back(Binding.first);
+            Children.push_back(Binding.second);
+        }
+        Children.push_back(LetExp->GetBoundInExpression());
+    }
+
+    // Deleting an expression drops the reference counts of its
+    // children, so the children that are left referenced only by
+    // the table are collected next, and a single pass over the
+    // table is enough to free every unreachable expression
     void ExprManager::GC()
     {
-        vector<Expression> ToDelete;
-        do {
-            for (auto const& Elem : ToDelete) {
-                ExpSet.erase(Elem);
+        vector<const UserExpressionBase*> WorkList;
+        for (auto const& Exp : ExpSet) {
+            if (Exp->__GetRefCount() == 1) {
+                WorkList.push_back(Exp.GetPtr());
+            }
+        }
+
+        vector<Expression> Children;
+        while (WorkList.size() > 0) {
+            {
+                Expression Exp = const_cast<UserExpressionBase*>(WorkList.back());
+                WorkList.pop_back();
+                GatherChildren(Exp, Children);
+                ExpSet.erase(Exp);
             }
-            ToDelete.clear();
-            for (auto it = ExpSet.begin(); it != ExpSet.end(); ++it) {
-                if ((*it)->__GetRefCount() == 1) {
-                    ToDelete.push_back(*it);
+
+            // The children are now referenced by the table and by
+            // Children, if by nothing else
+            sort(Children.begin(), Children.end());
+            Children.erase(unique(Children.begin(), Children.end()), Children.end());
+            for (auto const& Child : Children) {
+                if (Child->__GetRefCount() != 2) {
+                    continue;
+                }
+                auto it = ExpSet.find(Child);
+                if (it != ExpSet.end() && it->GetPtr() == Child.GetPtr()) {
+                    WorkList.push_back(Child.GetPtr());
                 }
             }
-        } while (ToDelete.size() > 0);
+            Children.clear();
+        }
+
+        GCThreshold = max((uint64)ESOLVER_EXPR_MANAGER_MIN_GC_THRESHOLD,
+                          (uint64)ExpSet.size() * 2);
+    }
+
+    uint64 ExprManager::GetNumExps() const
+    {
+        return ExpSet.size();
     }
 } /* end namespace */
 
@@ -50,12 +50,20 @@ namespace ESolver {
     {
     private:
         ExpressionSet ExpSet;
+        // The table is collected when it grows beyond this size, which
+        // is twice the number of live expressions after the last
+        // collection, so that the cost of collection is amortized
+        uint64 GCThreshold;
+
+        static void GatherChildren(const Expression& Exp, vector<Expression>& Children);
 
     public:
         ExprManager();
         ~ExprManager();
         Expression GetExp(const Expression& Exp);
+        // Frees the expressions that are referenced only by the table
         void GC();
+        uint64 GetNumExps() const;
     };
 
 } /* end namespace */
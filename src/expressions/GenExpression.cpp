@@ -54,6 +54,7 @@ namespace ESolver {
     ConcreteValueBase** GenExpressionBase::EvalStack;
     uint32 GenExpressionBase::EvalStackTop;
     uint64 GenExpressionBase::FreshVarID;
+    vector<const ConcreteValueBase*> GenExpressionBase::ConstHoleBindings;
 
     GenExpressionBase::GenExpressionBase()
     {
@@ -145,6 +146,20 @@ namespace ESolver {
         return Exp->ToUserExpression(Solver, BoundOps);
     }
 
+    void GenExpressionBase::BindConstHole(const UQVarOperator* HoleOp, const ConcreteValueBase* Value)
+    {
+        const uint32 Position = HoleOp->GetPosition();
+        if (ConstHoleBindings.size() <= Position) {
+            ConstHoleBindings.resize(Position + 1, nullptr);
+        }
+        ConstHoleBindings[Position] = Value;
+    }
+
+    void GenExpressionBase::ClearConstHoleBindings()
+    {
+        ConstHoleBindings.assign(ConstHoleBindings.size(), nullptr);
+    }
+
     GenLetVarExpression::GenLetVarExpression(const LetBoundVarOperator* Op)
         : GenExpressionBase(), Op(Op)
     {
@@ -198,6 +213,11 @@ namespace ESolver {
         return LetBindingValStack[LetBindingValStackTop][Op->GetPosition()]->GetType();
     }
 
+    bool GenLetVarExpression::HasConstHoles() const
+    {
+        return false;
+    }
+
     uint32 GenLetVarExpression::GetVarID() const
     {
         return Op->GetPosition();
@@ -252,6 +272,16 @@ namespace ESolver {
         return Op->GetEvalType();
     }
 
+    bool GenFPExpression::HasConstHoles() const
+    {
+        return false;
+    }
+
+    const FormalParamOperator* GenFPExpression::GetOp() const
+    {
+        return Op;
+    }
+
     GenConstExpression::GenConstExpression(const ConstOperator* Op)
         : Op(Op)
     {
@@ -295,17 +325,107 @@ namespace ESolver {
         return Solver->CreateExpression(Op);
     }
 
+    bool GenConstExpression::HasConstHoles() const
+    {
+        return false;
+    }
+
+    const ConstOperator* GenConstExpression::GetOp() const
+    {
+        return Op;
+    }
+
+    GenConstHoleExpression::GenConstHoleExpression(const UQVarOperator* Op)
+        : Op(Op)
+    {
+        // Nothing here
+    }
+
+    GenConstHoleExpression::~GenConstHoleExpression()
+    {
+        // Nothing here
+    }
+
+    string GenConstHoleExpression::ToString() const
+    {
+        const uint32 Position = Op->GetPosition();
+        if (Position < ConstHoleBindings.size() && ConstHoleBindings[Position] != nullptr) {
+            return ConstHoleBindings[Position]->ToString();
+        }
+        return "(Constant " + Op->GetEvalType()->ToString() + ")";
+    }
+
+    void GenConstHoleExpression::Evaluate(const uint32* ParamMap,
+                                          VariableMap VarMap) const
+    {
+        if (PartialExpression) {
+            return;
+        }
+        // An unbound hole cannot be evaluated, treat it
+        // the same way as an unbound let variable
+        const uint32 Position = Op->GetPosition();
+        if (Position >= ConstHoleBindings.size() || ConstHoleBindings[Position] == nullptr) {
+            PartialExpression = true;
+            return;
+        }
+        EvalStack[EvalStackTop++] = const_cast<ConcreteValueBase*>(ConstHoleBindings[Position]);
+    }
+
+    SMTExpr GenConstHoleExpression::ToSMT(TheoremProver* TP,
+                                          const uint32* ParamMap,
+                                          const vector<SMTExpr>& BaseExprs,
+                                          vector<SMTExpr>& Assumptions) const
+    {
+        const uint32 Position = Op->GetPosition();
+        if (Position < ConstHoleBindings.size() && ConstHoleBindings[Position] != nullptr) {
+            return ConstHoleBindings[Position]->ToSMT(TP);
+        }
+        // Unbound holes are left as free variables for the solver to pick
+        return TP->CreateVarExpr(Op->GetName(), Op->GetEvalType()->GetSMTType());
+    }
+
+    const ESFixedTypeBase* GenConstHoleExpression::GetType() const
+    {
+        return Op->GetEvalType();
+    }
+
+    Expression GenConstHoleExpression::ToUserExpression(ESolver* Solver,
+                                                        const map<uint32, const LetBoundVarOperator*>& BoundOps) const
+    {
+        const uint32 Position = Op->GetPosition();
+        if (Position >= ConstHoleBindings.size() || ConstHoleBindings[Position] == nullptr) {
+            throw InternalError((string)"Internal Error: Constant hole \"" + Op->GetName() +
+                                "\" has no value bound to it!\n" +
+                                "At: " + __FILE__ + ":" + to_string(__LINE__));
+        }
+        return Solver->CreateExpression(Solver->CreateConstant(ConstHoleBindings[Position]));
+    }
+
+    bool GenConstHoleExpression::HasConstHoles() const
+    {
+        return true;
+    }
+
+    const UQVarOperator* GenConstHoleExpression::GetOp() const
+    {
+        return Op;
+    }
+
     GenFuncExpression::GenFuncExpression(const InterpretedFuncOperator* Op,
                                          GenExpressionBase const* const* Children)
-        : Op(Op), Children(Children)
+        : Op(Op)
     {
-        // Nothing here
+        auto MyChildren = reinterpret_cast<GenExpressionBase const**>(this + 1);
+        const uint32 NumChildren = Op->GetArity();
+        for (uint32 i = 0; i < NumChildren; ++i) {
+            MyChildren[i] = Children[i];
+        }
     }
 
     GenFuncExpression::~GenFuncExpression()
     {
-        // The children are assumed to come from a pool
-        // and thus will not be freed by the class
+        // The children are stored in the same allocation
+        // and are not owned by the expression
     }
 
     string GenFuncExpression::ToString() const
@@ -313,7 +433,7 @@ namespace ESolver {
         ostringstream sstr;
         sstr << "(" << Op->GetName();
         for(uint32 i = 0; i < Op->GetArity(); ++i) {
-            sstr << " " << Children[i]->ToString();
+            sstr << " " << GetChildren()[i]->ToString();
         }
         sstr << ")";
         return sstr.str();
@@ -326,15 +446,36 @@ namespace ESolver {
             return;
         }
         const uint32 NumChildren = Op->GetArity();
+        auto Functor = Op->GetConcFunctor();
+        auto Result = GetCV();
+        const bool Lazy = Op->IsLazy();
+        const uint32 Base = EvalStackTop;
         for(uint32 i = 0; i < NumChildren; ++i) {
-            Children[i]->Evaluate(ParamMap, VarMap);
+            GetChildren()[i]->Evaluate(ParamMap, VarMap);
             if (PartialExpression) {
                 return;
             }
+            if (!Lazy || i + 1 == NumChildren) {
+                continue;
+            }
+            auto Action = Functor->ShortCircuit(i, EvalStack[Base + i], Result);
+            if (Action == LAZY_EVAL_CONTINUE) {
+                continue;
+            }
+            if (Action == LAZY_EVAL_DONE) {
+                EvalStackTop = Base;
+                EvalStack[EvalStackTop++] = Result;
+            } else if (Action <= i) {
+                EvalStack[Base] = EvalStack[Base + Action];
+                EvalStackTop = Base + 1;
+            } else {
+                // The value of the selected child is the result
+                EvalStackTop = Base;
+                GetChildren()[Action]->Evaluate(ParamMap, VarMap);
+            }
+            return;
         }
         // results of evaluation are on the top of the stack now
-        auto Functor = Op->GetConcFunctor();
-        auto Result = GetCV();
         (*Functor)(&EvalStack[EvalStackTop - NumChildren], Result);
         EvalStackTop -= NumChildren;
         EvalStack[EvalStackTop++] = Result;
@@ -349,7 +490,7 @@ namespace ESolver {
         vector<SMTExpr> ChildSMT(NumChildren);
 
         for(uint32 i = 0; i < NumChildren; ++i) {
-            ChildSMT[i] = Children[i]->ToSMT(TP, ParamMap, BaseExprs, Assumptions);
+            ChildSMT[i] = GetChildren()[i]->ToSMT(TP, ParamMap, BaseExprs, Assumptions);
         }
         auto Functor = Op->GetSymbFunctor();
         return (*Functor)(TP, ChildSMT, Assumptions);
@@ -361,7 +502,7 @@ namespace ESolver {
         const uint32 NumChildren = Op->GetArity();
         vector<Expression> ChildUserExps(NumChildren);
         for (uint32 i = 0; i < NumChildren; ++i) {
-            ChildUserExps[i] = Children[i]->ToUserExpression(Solver, BoundOps);
+            ChildUserExps[i] = GetChildren()[i]->ToUserExpression(Solver, BoundOps);
         }
 
         return Solver->CreateExpression(Op, ChildUserExps);
@@ -372,6 +513,27 @@ namespace ESolver {
         return Op->GetEvalType();
     }
 
+    bool GenFuncExpression::HasConstHoles() const
+    {
+        const uint32 NumChildren = Op->GetArity();
+        for (uint32 i = 0; i < NumChildren; ++i) {
+            if (GetChildren()[i]->HasConstHoles()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const InterpretedFuncOperator* GenFuncExpression::GetOp() const
+    {
+        return Op;
+    }
+
+    GenExpressionBase const* const* GenFuncExpression::GetChildren() const
+    {
+        return reinterpret_cast<GenExpressionBase const* const*>(this + 1);
+    }
+
     GenLetExpression::GenLetExpression(GenExpressionBase const* const* Bindings,
                                        GenExpressionBase const* LetBoundExp,
                                        uint32 NumBindings)
@@ -495,6 +657,31 @@ namespace ESolver {
         return LetBoundExp->GetType();
     }
 
+    bool GenLetExpression::HasConstHoles() const
+    {
+        for (uint32 i = 0; i < NumBindings; ++i) {
+            if (Bindings[i] != nullptr && Bindings[i]->HasConstHoles()) {
+                return true;
+            }
+        }
+        return LetBoundExp->HasConstHoles();
+    }
+
+    GenExpressionBase const* const* GenLetExpression::GetBindings() const
+    {
+        return Bindings;
+    }
+
+    const GenExpressionBase* GenLetExpression::GetLetBoundExp() const
+    {
+        return LetBoundExp;
+    }
+
+    uint32 GenLetExpression::GetNumBindings() const
+    {
+        return NumBindings;
+    }
+
 } /* end namespace */
 
 //
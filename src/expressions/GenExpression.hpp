@@ -73,6 +73,10 @@ namespace ESolver {
         static uint32 EvalStackTop;
         static uint64 FreshVarID;
 
+        // Values currently bound to the constant holes,
+        // indexed by the position of the hole operator
+        static vector<const ConcreteValueBase*> ConstHoleBindings;
+
     public:
         static void Initialize();
         static void Finalize();
@@ -87,6 +91,9 @@ namespace ESolver {
         static Expression ToUserExpression(const GenExpressionBase* Exp,
                                            ESolver* Solver);
 
+        static void BindConstHole(const UQVarOperator* HoleOp, const ConcreteValueBase* Value);
+        static void ClearConstHoleBindings();
+
         GenExpressionBase();
         virtual ~GenExpressionBase();
 
@@ -103,6 +110,13 @@ namespace ESolver {
         virtual const ESFixedTypeBase* GetType() const = 0;
         virtual Expression ToUserExpression(ESolver* Solver,
                                             const map<uint32, const LetBoundVarOperator*>& BoundOps) const = 0;
+        virtual bool HasConstHoles() const = 0;
+
+        template<typename T>
+        const T* As() const
+        {
+            return dynamic_cast<const T*>(this);
+        }
     };
 
     class GenLetVarExpression : public GenExpressionBase
@@ -129,6 +143,7 @@ namespace ESolver {
         void SetVarID(uint32 VarID) const;
         virtual Expression ToUserExpression(ESolver* Solver,
                                             const map<uint32, const LetBoundVarOperator*>& BoundOps) const override;
+        virtual bool HasConstHoles() const override;
     };
 
     class GenFPExpression : public GenExpressionBase
@@ -152,6 +167,9 @@ namespace ESolver {
         virtual const ESFixedTypeBase* GetType() const override;
         virtual Expression ToUserExpression(ESolver* Solver,
                                             const map<uint32, const LetBoundVarOperator*>& BoundsOps) const override;
+        virtual bool HasConstHoles() const override;
+
+        const FormalParamOperator* GetOp() const;
     };
 
     class GenConstExpression : public GenExpressionBase
@@ -174,20 +192,54 @@ namespace ESolver {
         virtual const ESFixedTypeBase* GetType() const override;
         virtual Expression ToUserExpression(ESolver* Solver,
                                             const map<uint32, const LetBoundVarOperator*>& BoundOps) const override;
+        virtual bool HasConstHoles() const override;
+
+        const ConstOperator* GetOp() const;
     };
 
+    class GenConstHoleExpression : public GenExpressionBase
+    {
+    private:
+        const UQVarOperator* Op;
+
+    public:
+        GenConstHoleExpression(const UQVarOperator* Op);
+        virtual ~GenConstHoleExpression();
+
+        virtual string ToString() const override;
+        virtual void Evaluate(const uint32* ParamMap,
+                              VariableMap VarMap) const override;
+
+        virtual SMTExpr ToSMT(TheoremProver* TP, const uint32* ParamMap,
+                              const vector<SMTExpr>& BaseExprs,
+                              vector<SMTExpr>& Assumptions) const override;
+
+        virtual const ESFixedTypeBase* GetType() const override;
+        virtual Expression ToUserExpression(ESolver* Solver,
+                                            const map<uint32, const LetBoundVarOperator*>& BoundOps) const override;
+        virtual bool HasConstHoles() const override;
+
+        const UQVarOperator* GetOp() const;
+    };
+
+    // The children are stored right after the expression, in the same
+    // allocation, which must be GetSize(Arity) bytes long
     class GenFuncExpression : public GenExpressionBase
     {
     private:
         const InterpretedFuncOperator* Op;
-        mutable GenExpressionBase const* const* Children;
 
     public:
-        // Takes ownership of children
+        // Copies the children
         GenFuncExpression(const InterpretedFuncOperator* Op,
                           GenExpressionBase const* const* Children);
         virtual ~GenFuncExpression();
 
+        static inline uint64 GetSize(uint32 Arity)
+        {
+            return sizeof(GenFuncExpression) + sizeof(GenExpressionBase const*) * Arity;
+        }
+
         virtual string ToString() const override;
         virtual void Evaluate(const uint32* ParamMap,
                               VariableMap VarMap) const override;
@@ -199,6 +251,10 @@ namespace ESolver {
         virtual const ESFixedTypeBase* GetType() const override;
         virtual Expression ToUserExpression(ESolver* Solver,
                                             const map<uint32, const LetBoundVarOperator*>& BoundOps) const override;
+        virtual bool HasConstHoles() const override;
+
+        const InterpretedFuncOperator* GetOp() const;
+        GenExpressionBase const* const* GetChildren() const;
     };
 
     class GenLetExpression : public GenExpressionBase
@@ -227,6 +283,11 @@ namespace ESolver {
 
         virtual Expression ToUserExpression(ESolver* Solver,
                                             const map<uint32, const LetBoundVarOperator*>& BoundOps) const override;
+        virtual bool HasConstHoles() const override;
+
+        GenExpressionBase const* const* GetBindings() const;
+        const GenExpressionBase* GetLetBoundExp() const;
+        uint32 GetNumBindings() const;
     };
 
 } /* End namespace */
@@ -403,11 +403,29 @@ namespace ESolver {
                                                  VariableMap VarMap,
                                                  ConcreteValueBase* Result) const
     {
+        auto FuncOp = static_cast<const InterpretedFuncOperator*>(Op);
+        auto Functor = FuncOp->GetConcFunctor();
+        const bool Lazy = FuncOp->IsLazy();
         for (uint32 i = 0; i < NumChildren; ++i) {
             Children[i]->Evaluate(SubstExps, VarMap,
                                   const_cast<ConcreteValueBase*>(ChildEvals[i]));
+            if (!Lazy || i + 1 == NumChildren) {
+                continue;
+            }
+            auto Action = Functor->ShortCircuit(i, ChildEvals[i], Result);
+            if (Action == LAZY_EVAL_CONTINUE) {
+                continue;
+            }
+            if (Action == LAZY_EVAL_DONE) {
+                return;
+            }
+            if (Action <= i) {
+                new (Result) ConcreteValueBase(*ChildEvals[Action]);
+            } else {
+                Children[Action]->Evaluate(SubstExps, VarMap, Result);
+            }
+            return;
         }
-        auto Functor = static_cast<const InterpretedFuncOperator*>(Op)->GetConcFunctor();
         (*Functor)(ChildEvals, Result);
     }
 
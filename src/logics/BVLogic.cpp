@@ -39,9 +39,11 @@
 
 
 #include "BVLogic.hpp"
+#include "BVNativeFunctors.hpp"
 #include "../descriptions/ESType.hpp"
 #include "../z3interface/TheoremProver.hpp"
 #include "../descriptions/Builtins.hpp"
+#include "../descriptions/Operators.hpp"
 #include "../values/ConcreteValueBase.hpp"
 #include "../solvers/ESolver.hpp"
 #include <iostream>
@@ -90,14 +92,25 @@ namespace ESolver {
 
 namespace ESolverBVLogic {
 
+    // The limbs of a bitvector value of any width
+    static inline WideBVLimbs ToLimbs(const ConcreteValueBase* Value, const ESBVType* Type)
+    {
+        if (WideBV::IsWide(Type->GetSize())) {
+            return Type->GetStore()->Get(Value->GetValue());
+        }
+        return WideBV::FromWord((uint64)Value->GetValue(), Type->GetSize());
+    }
+
     BVConcreteFunctor::BVConcreteFunctor(const ESFixedTypeBase* Type,
                                          const ESFixedTypeBase* BoolType)
         : ConcFunctorBase(), Type(Type), BoolType(BoolType)
     {
         // Construct the mask
         Mask = 0;
-        const uint32 NumBits = Type->As<ESBVType>()->GetSize();
-        if (NumBits == 64) {
+        NumBits = Type->As<ESBVType>()->GetSize();
+        Wide = WideBV::IsWide(NumBits);
+        Store = Type->As<ESBVType>()->GetStore();
+        if (NumBits >= 64) {
             Mask = (uint64)0xFFFFFFFFFFFFFFFF;
         } else {
             Mask = (((uint64)1 << NumBits) - 1);
@@ -111,8 +124,10 @@ namespace ESolverBVLogic {
     {
         // Construct the mask
         Mask = 0;
-        const uint32 NumBits = Type->As<ESBVType>()->GetSize();
-        if (NumBits == 64) {
+        NumBits = Type->As<ESBVType>()->GetSize();
+        Wide = WideBV::IsWide(NumBits);
+        Store = Type->As<ESBVType>()->GetStore();
+        if (NumBits >= 64) {
             Mask = (uint64)0xFFFFFFFFFFFFFFFF;
         } else {
             Mask = (((uint64)1 << NumBits) - 1);
@@ -124,6 +139,17 @@ namespace ESolverBVLogic {
         // Nothing here
     }
 
+    const WideBVLimbs& BVConcreteFunctor::WideArg(EvalMap Args, uint32 Index) const
+    {
+        return Store->Get(Args[Index]->GetValue());
+    }
+
+    void BVConcreteFunctor::SetWideResult(ConcreteValueBase* Result,
+                                          const WideBVLimbs& Limbs) const
+    {
+        new (Result) ConcreteValueBase(Type, Store->Intern(Limbs));
+    }
+
     BVSymbolicFunctor::BVSymbolicFunctor(const ESFixedTypeBase* Type,
                                          const ESFixedTypeBase* BoolType)
         : SymbFunctorBase(), Type(Type), BoolType(BoolType)
@@ -152,6 +178,11 @@ namespace ESolverBVLogic {
     void BVAddConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Add(WideArg(Args, 0), WideArg(Args, 1), NumBits));
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         int64 Arg2 = Args[1]->GetValue();
         uint32 Shift = 64 - Type->As<ESBVType>()->GetSize();
@@ -169,6 +200,21 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVAddConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        // Sign extending the args does not change the low bits of the sum
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (Arg1[i] + Arg2[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVAddConcreteFunctor::Clone() const
     {
         return new BVAddConcreteFunctor(Type, BoolType, GetID());
@@ -209,6 +255,11 @@ namespace ESolverBVLogic {
     void BVSubConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Sub(WideArg(Args, 0), WideArg(Args, 1), NumBits));
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         int64 Arg2 = Args[1]->GetValue();
         const uint32 Shift = 64 - Type->As<ESBVType>()->GetSize();
@@ -226,6 +277,21 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVSubConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        // Sign extending the args does not change the low bits of the difference
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (Arg1[i] - Arg2[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVSubConcreteFunctor::Clone() const
     {
         return new BVSubConcreteFunctor(Type, BoolType, GetID());
@@ -266,6 +332,11 @@ namespace ESolverBVLogic {
     void BVAndConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::And(WideArg(Args, 0), WideArg(Args, 1)));
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         int64 Arg2 = Args[1]->GetValue();
 
@@ -274,6 +345,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVAndConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (Arg1[i] & Arg2[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVAndConcreteFunctor::Clone() const
     {
         return new BVAndConcreteFunctor(Type, BoolType, GetID());
@@ -314,6 +399,11 @@ namespace ESolverBVLogic {
     void BVOrConcreteFunctor::operator () (EvalMap Args,
                                            ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Or(WideArg(Args, 0), WideArg(Args, 1)));
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         int64 Arg2 = Args[1]->GetValue();
         int64 ResultVal = Arg1 | Arg2;
@@ -321,6 +411,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVOrConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                            int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (Arg1[i] | Arg2[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVOrConcreteFunctor::Clone() const
     {
         return new BVOrConcreteFunctor(Type, BoolType, GetID());
@@ -361,12 +465,30 @@ namespace ESolverBVLogic {
     void BVNotConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Not(WideArg(Args, 0), NumBits));
+            return;
+        }
+
         int64 Arg = Args[0]->GetValue();
         int64 ResultVal = ~Arg;
         ResultVal = ResultVal & Mask;
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVNotConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg = (const uint64*)Args[0];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (~Arg[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVNotConcreteFunctor::Clone() const
     {
         return new BVNotConcreteFunctor(Type, BoolType, GetID());
@@ -407,6 +529,11 @@ namespace ESolverBVLogic {
     void BVNandConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Not(WideBV::And(WideArg(Args, 0), WideArg(Args, 1)), NumBits));
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         int64 Arg2 = Args[1]->GetValue();
 
@@ -416,6 +543,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVNandConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (~(Arg1[i] & Arg2[i])) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVNandConcreteFunctor::Clone() const
     {
         return new BVNandConcreteFunctor(Type, BoolType, GetID());
@@ -456,6 +597,11 @@ namespace ESolverBVLogic {
     void BVNorConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Not(WideBV::Or(WideArg(Args, 0), WideArg(Args, 1)), NumBits));
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         int64 Arg2 = Args[1]->GetValue();
 
@@ -465,6 +611,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVNorConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (~(Arg1[i] | Arg2[i])) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVNorConcreteFunctor::Clone() const
     {
         return new BVNorConcreteFunctor(Type, BoolType, GetID());
@@ -505,6 +665,11 @@ namespace ESolverBVLogic {
     void BVXorConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Xor(WideArg(Args, 0), WideArg(Args, 1)));
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         int64 Arg2 = Args[1]->GetValue();
 
@@ -513,6 +678,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVXorConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (Arg1[i] ^ Arg2[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVXorConcreteFunctor::Clone() const
     {
         return new BVXorConcreteFunctor(Type, BoolType, GetID());
@@ -553,6 +732,11 @@ namespace ESolverBVLogic {
     void BVXNorConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Not(WideBV::Xor(WideArg(Args, 0), WideArg(Args, 1)), NumBits));
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         int64 Arg2 = Args[1]->GetValue();
 
@@ -562,6 +746,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVXNorConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (~(Arg1[i] ^ Arg2[i])) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVXNorConcreteFunctor::Clone() const
     {
         return new BVXNorConcreteFunctor(Type, BoolType, GetID());
@@ -602,6 +800,11 @@ namespace ESolverBVLogic {
     void BVShlConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Shl(WideArg(Args, 0), WideArg(Args, 1), NumBits));
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
         uint64 ResultBits;
@@ -616,6 +819,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultBits);
     }
 
+    void BVShlConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (Arg2[i] < 64 ? Arg1[i] << (Arg2[i] & 63) : 0) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVShlConcreteFunctor::Clone() const
     {
         return new BVShlConcreteFunctor(Type, BoolType, GetID());
@@ -657,6 +874,11 @@ namespace ESolverBVLogic {
     void BVAShrConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::AShr(WideArg(Args, 0), WideArg(Args, 1), NumBits));
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
         const uint32 Shift = 64 - Type->As<ESBVType>()->GetSize();
@@ -682,6 +904,22 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultBits);
     }
 
+    void BVAShrConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint32 Shift = 64 - Type->As<ESBVType>()->GetSize();
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            int64 Arg1 = SignExtend(Args[0][i], Shift);
+            int64 ResultBits = (Arg2[i] < 64 ? Arg1 >> (Arg2[i] & 63) : Arg1 >> 63);
+            Result[i] = ResultBits & Mask;
+        }
+    }
+
     ConcFunctorBase* BVAShrConcreteFunctor::Clone() const
     {
         return new BVAShrConcreteFunctor(Type, BoolType, GetID());
@@ -722,6 +960,11 @@ namespace ESolverBVLogic {
     void BVLShrConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::LShr(WideArg(Args, 0), WideArg(Args, 1), NumBits));
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
         uint64 ResultBits;
@@ -737,6 +980,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultBits);
     }
 
+    void BVLShrConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (Arg2[i] < 64 ? Arg1[i] >> (Arg2[i] & 63) : 0) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVLShrConcreteFunctor::Clone() const
     {
         return new BVLShrConcreteFunctor(Type, BoolType, GetID());
@@ -777,6 +1034,11 @@ namespace ESolverBVLogic {
     void BVNegConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Neg(WideArg(Args, 0), NumBits));
+            return;
+        }
+
         int64 Arg = Args[0]->GetValue();
         const uint32 Shift = 64 - Type->As<ESBVType>()->GetSize();
 
@@ -792,6 +1054,19 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultBits);
     }
 
+    void BVNegConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg = (const uint64*)Args[0];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (-Arg[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVNegConcreteFunctor::Clone() const
     {
         return new BVNegConcreteFunctor(Type, BoolType, GetID());
@@ -832,6 +1107,11 @@ namespace ESolverBVLogic {
     void BVUSLEConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, WideBV::UCompare(WideArg(Args, 0), WideArg(Args, 1)) <= 0 ? 1 : 0);
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
 
@@ -839,6 +1119,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(BoolType, ResultVal);
     }
 
+    void BVUSLEConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] <= Arg2[i] ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVUSLEConcreteFunctor::Clone() const
     {
         return new BVUSLEConcreteFunctor(Type, BoolType, GetID());
@@ -879,6 +1173,11 @@ namespace ESolverBVLogic {
     void BVUSGTConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, WideBV::UCompare(WideArg(Args, 0), WideArg(Args, 1)) > 0 ? 1 : 0);
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
 
@@ -886,6 +1185,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(BoolType, ResultVal);
     }
 
+    void BVUSGTConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] > Arg2[i] ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVUSGTConcreteFunctor::Clone() const
     {
         return new BVUSGTConcreteFunctor(Type, BoolType, GetID());
@@ -926,6 +1239,18 @@ namespace ESolverBVLogic {
     void BVUSDivConcreteFunctor::operator () (EvalMap Args,
                                               ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            WideBVLimbs Quotient, Remainder;
+            if (WideBV::IsZero(WideArg(Args, 1))) {
+                ConcreteException = true;
+                Quotient = WideBV::Not(WideBVLimbs(), NumBits);
+            } else {
+                WideBV::DivRem(WideArg(Args, 0), WideArg(Args, 1), NumBits, Quotient, Remainder);
+            }
+            SetWideResult(Result, Quotient);
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
         uint64 ResultVal;
@@ -942,6 +1267,21 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVUSDivConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                               int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Exceptions[i] |= (uint8)(Arg2[i] == 0 ? BATCH_LANE_EXCEPTION : 0);
+            Result[i] = (Arg2[i] == 0 ? UINT64_MAX : Arg1[i] / Arg2[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVUSDivConcreteFunctor::Clone() const
     {
         return new BVUSDivConcreteFunctor(Type, BoolType, GetID());
@@ -982,6 +1322,28 @@ namespace ESolverBVLogic {
     void BVSDivConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            auto Arg1 = WideArg(Args, 0);
+            auto Arg2 = WideArg(Args, 1);
+            WideBVLimbs Quotient, Remainder;
+            if (WideBV::IsZero(Arg2)) {
+                ConcreteException = true;
+                Quotient = WideBV::Not(WideBVLimbs(), NumBits);
+            } else {
+                // Divide the magnitudes, the quotient truncates towards zero
+                const bool Neg1 = WideBV::IsNegative(Arg1, NumBits);
+                const bool Neg2 = WideBV::IsNegative(Arg2, NumBits);
+                WideBV::DivRem(Neg1 ? WideBV::Neg(Arg1, NumBits) : Arg1,
+                               Neg2 ? WideBV::Neg(Arg2, NumBits) : Arg2,
+                               NumBits, Quotient, Remainder);
+                if (Neg1 != Neg2) {
+                    Quotient = WideBV::Neg(Quotient, NumBits);
+                }
+            }
+            SetWideResult(Result, Quotient);
+            return;
+        }
+
         int64 Arg1 = (uint64)Args[0]->GetValue();
         int64 Arg2 = (uint64)Args[1]->GetValue();
         int64 ResultVal;
@@ -996,15 +1358,7 @@ namespace ESolverBVLogic {
             ConcreteException = true;
             ResultVal = (Arg1 < 0 ? INT64_MIN : INT64_MAX);
         } else {
-            if (Arg1 > 0 && Arg2 > 0) {
-                ResultVal = (uint64)Arg1 / (uint64)Arg2;
-            } else if (Arg1 < 0 && Arg2 > 0) {
-                ResultVal = -((int64)(((uint64)(-Arg1)) / (uint64)Arg2));
-            } else if (Arg1 > 0 && Arg2 < 0) {
-                ResultVal = -((int64)((uint64)Arg1 / ((uint64)(-Arg2))));
-            } else {
-                ResultVal = (uint64)(-Arg1) / (uint64)(-Arg2);
-            }
+            ResultVal = SignedDivide(Arg1, Arg2);
         }
 
         // Mask off the result
@@ -1013,6 +1367,28 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVSDivConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint32 Shift = 64 - Type->As<ESBVType>()->GetSize();
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            int64 Arg1 = SignExtend(Args[0][i], Shift);
+            int64 Arg2 = SignExtend(Args[1][i], Shift);
+            int64 ResultVal;
+            if (Arg2 == 0) {
+                Exceptions[i] = 1;
+                ResultVal = (Arg1 < 0 ? INT64_MIN : INT64_MAX);
+            } else {
+                ResultVal = SignedDivide(Arg1, Arg2);
+            }
+            Result[i] = ResultVal & Mask;
+        }
+    }
+
     ConcFunctorBase* BVSDivConcreteFunctor::Clone() const
     {
         return new BVSDivConcreteFunctor(Type, BoolType, GetID());
@@ -1053,6 +1429,18 @@ namespace ESolverBVLogic {
     void BVUSRemConcreteFunctor::operator () (EvalMap Args,
                                               ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            WideBVLimbs Quotient, Remainder;
+            if (WideBV::IsZero(WideArg(Args, 1))) {
+                ConcreteException = true;
+                Remainder = WideBV::Not(WideBVLimbs(), NumBits);
+            } else {
+                WideBV::DivRem(WideArg(Args, 0), WideArg(Args, 1), NumBits, Quotient, Remainder);
+            }
+            SetWideResult(Result, Remainder);
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
         uint64 ResultVal;
@@ -1067,6 +1455,21 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVUSRemConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                               int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Exceptions[i] |= (uint8)(Arg2[i] == 0 ? BATCH_LANE_EXCEPTION : 0);
+            Result[i] = (Arg2[i] == 0 ? UINT64_MAX : Arg1[i] % Arg2[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVUSRemConcreteFunctor::Clone() const
     {
         return new BVUSRemConcreteFunctor(Type, BoolType, GetID());
@@ -1107,6 +1510,28 @@ namespace ESolverBVLogic {
     void BVSRemConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            auto Arg1 = WideArg(Args, 0);
+            auto Arg2 = WideArg(Args, 1);
+            WideBVLimbs Quotient, Remainder;
+            if (WideBV::IsZero(Arg2)) {
+                ConcreteException = true;
+                Remainder = WideBV::Not(WideBVLimbs(), NumBits);
+            } else {
+                // The remainder takes the sign of the dividend
+                const bool Neg1 = WideBV::IsNegative(Arg1, NumBits);
+                const bool Neg2 = WideBV::IsNegative(Arg2, NumBits);
+                WideBV::DivRem(Neg1 ? WideBV::Neg(Arg1, NumBits) : Arg1,
+                               Neg2 ? WideBV::Neg(Arg2, NumBits) : Arg2,
+                               NumBits, Quotient, Remainder);
+                if (Neg1) {
+                    Remainder = WideBV::Neg(Remainder, NumBits);
+                }
+            }
+            SetWideResult(Result, Remainder);
+            return;
+        }
+
         int64 Arg1 = Args[0]->GetValue();
         int64 Arg2 = Args[1]->GetValue();
         const uint32 Shift = 64 - Type->As<ESBVType>()->GetSize();
@@ -1122,20 +1547,34 @@ namespace ESolverBVLogic {
             ConcreteException = true;
             ResultVal = INT64_MAX;
         } else {
-            if (Arg1 >= 0 && Arg2 > 0) {
-                ResultVal = (uint64)Arg1 % (uint64)Arg2;
-            } else if (Arg1 < 0 && Arg2 > 0) {
-                ResultVal = -((int64)(((uint64)(-Arg1)) % (uint64)Arg2));
-            } else if (Arg1 >= 0 && Arg2 < 0) {
-                ResultVal = (int64)((uint64)Arg1 % ((uint64)(-Arg2)));
-            } else {
-                ResultVal = -((int64)(((uint64)(-Arg1)) % ((uint64)(-Arg2))));
-            }
+            ResultVal = SignedRemainder(Arg1, Arg2);
         }
 
+        // Mask off the result
+        ResultVal = ResultVal & Mask;
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVSRemConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint32 Shift = 64 - Type->As<ESBVType>()->GetSize();
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            int64 Arg1 = SignExtend(Args[0][i], Shift);
+            int64 Arg2 = SignExtend(Args[1][i], Shift);
+            if (Arg2 == 0) {
+                Exceptions[i] = 1;
+                Result[i] = INT64_MAX & Mask;
+            } else {
+                Result[i] = SignedRemainder(Arg1, Arg2) & Mask;
+            }
+        }
+    }
+
     ConcFunctorBase* BVSRemConcreteFunctor::Clone() const
     {
         return new BVSRemConcreteFunctor(Type, BoolType, GetID());
@@ -1176,6 +1615,11 @@ namespace ESolverBVLogic {
     void BVMulConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            SetWideResult(Result, WideBV::Mul(WideArg(Args, 0), WideArg(Args, 1), NumBits));
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
 
@@ -1184,6 +1628,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(Type, ResultVal);
     }
 
+    void BVMulConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (Arg1[i] * Arg2[i]) & Mask;
+        }
+    }
+
     ConcFunctorBase* BVMulConcreteFunctor::Clone() const
     {
         return new BVMulConcreteFunctor(Type, BoolType, GetID());
@@ -1224,11 +1682,29 @@ namespace ESolverBVLogic {
     void BVToBoolConcreteFunctor::operator () (EvalMap Args,
                                                ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, !WideBV::IsZero(WideArg(Args, 0)) ? 1 : 0);
+            return;
+        }
+
         int64 Arg = Args[0]->GetValue();
         int64 ResultVal = Arg != 0 ? 1 : 0;
         new (Result) ConcreteValueBase(BoolType, ResultVal);
     }
 
+    void BVToBoolConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                                int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg = (const uint64*)Args[0];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg[i] != 0 ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVToBoolConcreteFunctor::Clone() const
     {
         return new BVToBoolConcreteFunctor(Type, BoolType, GetID());
@@ -1284,6 +1760,13 @@ namespace ESolverBVLogic {
     void BVToSIntConcreteFunctor::operator () (EvalMap Args,
                                                ConcreteValueBase* Result)
     {
+        if (UNLIKELY(WideBV::IsWide(BVType->As<ESBVType>()->GetSize()))) {
+            // Integers are 64 bits wide, keep the low word
+            new (Result) ConcreteValueBase(IntType, (int64)BVType->As<ESBVType>()->GetStore()->Get(
+                                               Args[0]->GetValue())[0]);
+            return;
+        }
+
         int64 Arg = Args[0]->GetValue();
         const uint32 Shift = 64 - BVType->As<ESBVType>()->GetSize();
         int64 ResultVal;
@@ -1295,6 +1778,20 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(IntType, ResultVal);
     }
 
+    void BVToSIntConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                                int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(WideBV::IsWide(BVType->As<ESBVType>()->GetSize()))) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint32 Shift = 64 - BVType->As<ESBVType>()->GetSize();
+        const int64* Arg = Args[0];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = SignExtend(Arg[i], Shift);
+        }
+    }
+
     ConcFunctorBase* BVToSIntConcreteFunctor::Clone() const
     {
         return new BVToSIntConcreteFunctor(BVType, IntType, GetID());
@@ -1351,10 +1848,29 @@ namespace ESolverBVLogic {
     void BVToUSIntConcreteFunctor::operator () (EvalMap Args,
                                                 ConcreteValueBase* Result)
     {
+        if (UNLIKELY(WideBV::IsWide(BVType->As<ESBVType>()->GetSize()))) {
+            new (Result) ConcreteValueBase(IntType, (int64)BVType->As<ESBVType>()->GetStore()->Get(
+                                               Args[0]->GetValue())[0]);
+            return;
+        }
+
         int64 Arg = (uint64)Args[0]->GetValue();
         new (Result) ConcreteValueBase(IntType, Arg);
     }
 
+    void BVToUSIntConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                                 int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(WideBV::IsWide(BVType->As<ESBVType>()->GetSize()))) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const int64* Arg = Args[0];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg[i];
+        }
+    }
+
     ConcFunctorBase* BVToUSIntConcreteFunctor::Clone() const
     {
         return new BVToUSIntConcreteFunctor(BVType, IntType, GetID());
@@ -1395,12 +1911,31 @@ namespace ESolverBVLogic {
     void BVUSLTConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, WideBV::UCompare(WideArg(Args, 0), WideArg(Args, 1)) < 0 ? 1 : 0);
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
         int64 Bits = Arg1 < Arg2 ? 1 : 0;
         new (Result) ConcreteValueBase(BoolType, Bits);
     }
 
+    void BVUSLTConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] < Arg2[i] ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVUSLTConcreteFunctor::Clone() const
     {
         return new BVUSLTConcreteFunctor(Type, BoolType, GetID());
@@ -1441,12 +1976,31 @@ namespace ESolverBVLogic {
     void BVUSGEConcreteFunctor::operator () (EvalMap Args,
                                              ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, WideBV::UCompare(WideArg(Args, 0), WideArg(Args, 1)) >= 0 ? 1 : 0);
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue();
         uint64 Arg2 = (uint64)Args[1]->GetValue();
         int64 Bits = Arg1 >= Arg2 ? 1 : 0;
         new (Result) ConcreteValueBase(BoolType, Bits);
     }
 
+    void BVUSGEConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                              int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] >= Arg2[i] ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVUSGEConcreteFunctor::Clone() const
     {
         return new BVUSGEConcreteFunctor(Type, BoolType, GetID());
@@ -1487,12 +2041,32 @@ namespace ESolverBVLogic {
     void BVSLEConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, WideBV::SCompare(WideArg(Args, 0), WideArg(Args, 1), NumBits) <= 0 ? 1 : 0);
+            return;
+        }
+
         uint64 Arg1 = (int64)Args[0]->GetValue();
         uint64 Arg2 = (int64)Args[1]->GetValue();
         int64 Bits = Arg1 <= Arg2 ? 1 : 0;
         new (Result) ConcreteValueBase(BoolType, Bits);
     }
 
+    void BVSLEConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        // Same comparison as the scalar version
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] <= Arg2[i] ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVSLEConcreteFunctor::Clone() const
     {
         return new BVSLEConcreteFunctor(Type, BoolType, GetID());
@@ -1533,12 +2107,32 @@ namespace ESolverBVLogic {
     void BVSLTConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, WideBV::SCompare(WideArg(Args, 0), WideArg(Args, 1), NumBits) < 0 ? 1 : 0);
+            return;
+        }
+
         uint64 Arg1 = (int64)Args[0]->GetValue();
         uint64 Arg2 = (int64)Args[1]->GetValue();
         int64 Bits = Arg1 < Arg2 ? 1 : 0;
         new (Result) ConcreteValueBase(BoolType, Bits);
     }
 
+    void BVSLTConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        // Same comparison as the scalar version
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] < Arg2[i] ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVSLTConcreteFunctor::Clone() const
     {
         return new BVSLTConcreteFunctor(Type, BoolType, GetID());
@@ -1579,12 +2173,32 @@ namespace ESolverBVLogic {
     void BVSGEConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, WideBV::SCompare(WideArg(Args, 0), WideArg(Args, 1), NumBits) >= 0 ? 1 : 0);
+            return;
+        }
+
         uint64 Arg1 = (int64)Args[0]->GetValue();
         uint64 Arg2 = (int64)Args[1]->GetValue();
         int64 Bits = Arg1 >= Arg2 ? 1 : 0;
         new (Result) ConcreteValueBase(BoolType, Bits);
     }
 
+    void BVSGEConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        // Same comparison as the scalar version
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] >= Arg2[i] ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVSGEConcreteFunctor::Clone() const
     {
         return new BVSGEConcreteFunctor(Type, BoolType, GetID());
@@ -1625,12 +2239,32 @@ namespace ESolverBVLogic {
     void BVSGTConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, WideBV::SCompare(WideArg(Args, 0), WideArg(Args, 1), NumBits) > 0 ? 1 : 0);
+            return;
+        }
+
         uint64 Arg1 = (int64)Args[0]->GetValue();
         uint64 Arg2 = (int64)Args[1]->GetValue();
         int64 Bits = Arg1 > Arg2 ? 1 : 0;
         new (Result) ConcreteValueBase(BoolType, Bits);
     }
 
+    void BVSGTConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        // Same comparison as the scalar version
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] > Arg2[i] ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVSGTConcreteFunctor::Clone() const
     {
         return new BVSGTConcreteFunctor(Type, BoolType, GetID());
@@ -1671,11 +2305,29 @@ namespace ESolverBVLogic {
     void BVRedOrConcreteFunctor::operator () (EvalMap Args,
                                               ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, !WideBV::IsZero(WideArg(Args, 0)) ? 1 : 0);
+            return;
+        }
+
         int64 Arg = Args[0]->GetValue();
         int64 ResultVal = Arg == 0 ? 0 : 1;
         new (Result) ConcreteValueBase(BoolType, ResultVal);
     }
 
+    void BVRedOrConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                               int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg = (const uint64*)Args[0];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg[i] != 0 ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVRedOrConcreteFunctor::Clone() const
     {
         return new BVRedOrConcreteFunctor(Type, BoolType, GetID());
@@ -1716,11 +2368,29 @@ namespace ESolverBVLogic {
     void BVRedAndConcreteFunctor::operator () (EvalMap Args,
                                                ConcreteValueBase* Result)
     {
+        if (UNLIKELY(Wide)) {
+            new (Result) ConcreteValueBase(BoolType, WideBV::IsZero(WideBV::Not(WideArg(Args, 0), NumBits)) ? 1 : 0);
+            return;
+        }
+
         int64 Arg = Args[0]->GetValue();
         int64 Retval = ((Arg & Mask) == Mask) ? 1 : 0;
         new (Result) ConcreteValueBase(BoolType, Retval);
     }
 
+    void BVRedAndConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                                int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(Wide)) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg = (const uint64*)Args[0];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = (Arg[i] & Mask) == Mask ? 1 : 0;
+        }
+    }
+
     ConcFunctorBase* BVRedAndConcreteFunctor::Clone() const
     {
         return new BVRedAndConcreteFunctor(Type, BoolType, GetID());
@@ -1759,17 +2429,17 @@ namespace ESolverBVLogic {
                                                      uint64 UID)
         : ConcFunctorBase(UID), Arg1Type(Arg1Type), Arg2Type(Arg2Type), RetType(RetType)
     {
-        if (Arg1Type->As<ESBVType>()->GetSize() == 64) {
+        if (Arg1Type->As<ESBVType>()->GetSize() >= 64) {
             Arg1Mask = (uint64)0xFFFFFFFFFFFFFFFF;
         } else {
             Arg1Mask  = ((uint64)1 << Arg1Type->As<ESBVType>()->GetSize()) - 1;
         }
-        if (Arg2Type->As<ESBVType>()->GetSize() == 64) {
+        if (Arg2Type->As<ESBVType>()->GetSize() >= 64) {
             Arg2Mask = (uint64)0xFFFFFFFFFFFFFFFF;
         } else {
             Arg2Mask  = ((uint64)1 << Arg2Type->As<ESBVType>()->GetSize()) - 1;
         }
-        if (RetType->As<ESBVType>()->GetSize() == 64) {
+        if (RetType->As<ESBVType>()->GetSize() >= 64) {
             RetMask = (uint64)0xFFFFFFFFFFFFFFFF;
         } else {
             RetMask  = ((uint64)1 << RetType->As<ESBVType>()->GetSize()) - 1;
@@ -1781,17 +2451,17 @@ namespace ESolverBVLogic {
                                                      const ESFixedTypeBase* RetType)
         : ConcFunctorBase(), Arg1Type(Arg1Type), Arg2Type(Arg2Type), RetType(RetType)
     {
-        if (Arg1Type->As<ESBVType>()->GetSize() == 64) {
+        if (Arg1Type->As<ESBVType>()->GetSize() >= 64) {
             Arg1Mask = (uint64)0xFFFFFFFFFFFFFFFF;
         } else {
             Arg1Mask  = (1 << Arg1Type->As<ESBVType>()->GetSize()) - 1;
         }
-        if (Arg2Type->As<ESBVType>()->GetSize() == 64) {
+        if (Arg2Type->As<ESBVType>()->GetSize() >= 64) {
             Arg2Mask = (uint64)0xFFFFFFFFFFFFFFFF;
         } else {
             Arg2Mask  = (1 << Arg2Type->As<ESBVType>()->GetSize()) - 1;
         }
-        if (RetType->As<ESBVType>()->GetSize() == 64) {
+        if (RetType->As<ESBVType>()->GetSize() >= 64) {
             RetMask = (uint64)0xFFFFFFFFFFFFFFFF;
         } else {
             RetMask  = (1 << RetType->As<ESBVType>()->GetSize()) - 1;
@@ -1806,6 +2476,17 @@ namespace ESolverBVLogic {
     void BVConcatConcreteFunctor::operator() (EvalMap Args,
                                               ConcreteValueBase* Result)
     {
+        const uint32 RetSize = RetType->As<ESBVType>()->GetSize();
+        if (UNLIKELY(WideBV::IsWide(RetSize))) {
+            const uint32 Arg1Size = Arg1Type->As<ESBVType>()->GetSize();
+            const uint32 Arg2Size = Arg2Type->As<ESBVType>()->GetSize();
+            auto ResultLimbs = WideBV::Concat(ToLimbs(Args[0], Arg1Type->As<ESBVType>()), Arg1Size,
+                                              ToLimbs(Args[1], Arg2Type->As<ESBVType>()), Arg2Size);
+            new (Result) ConcreteValueBase(RetType,
+                                           RetType->As<ESBVType>()->GetStore()->Intern(ResultLimbs));
+            return;
+        }
+
         uint64 Arg1 = (uint64)Args[0]->GetValue() & Arg1Mask;
         uint64 Arg2 = (uint64)Args[1]->GetValue() & Arg2Mask;
         // Mask the args for good measure
@@ -1814,6 +2495,21 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(RetType, ResultBits);
     }
 
+    void BVConcatConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                                int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(WideBV::IsWide(RetType->As<ESBVType>()->GetSize()))) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint32 Shift = Arg1Type->As<ESBVType>()->GetSize();
+        const uint64* Arg1 = (const uint64*)Args[0];
+        const uint64* Arg2 = (const uint64*)Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = ((Arg1[i] & Arg1Mask) << Shift | (Arg2[i] & Arg2Mask)) & RetMask;
+        }
+    }
+
     string BVConcatConcreteFunctor::ToString() const
     {
         return "BVConcatConcreteFunctor";
@@ -1871,7 +2567,12 @@ namespace ESolverBVLogic {
           Low(Low), High(High)
     {
 
-        if (Low == 0 && High == 63) {
+        if (High > 63) {
+            // Wide arguments do not use the masks
+            ExtractMask = (uint64)0xFFFFFFFFFFFFFFFF;
+            ResultMask = (uint64)0xFFFFFFFFFFFFFFFF;
+            ExtractShift = 0;
+        } else if (Low == 0 && High == 63) {
             ExtractMask = (uint64)0xFFFFFFFFFFFFFFFF;
             ResultMask = (uint64)0xFFFFFFFFFFFFFFFF;
             ExtractShift = 0;
@@ -1892,7 +2593,12 @@ namespace ESolverBVLogic {
         : ConcFunctorBase(), ArgType(ArgType), RetType(RetType),
           Low(Low), High(High)
     {
-        if (Low == 0 && High == 63) {
+        if (High > 63) {
+            // Wide arguments do not use the masks
+            ExtractMask = (uint64)0xFFFFFFFFFFFFFFFF;
+            ResultMask = (uint64)0xFFFFFFFFFFFFFFFF;
+            ExtractShift = 0;
+        } else if (Low == 0 && High == 63) {
             ExtractMask = (uint64)0xFFFFFFFFFFFFFFFF;
             ResultMask = (uint64)0xFFFFFFFFFFFFFFFF;
             ExtractShift = 0;
@@ -1915,6 +2621,17 @@ namespace ESolverBVLogic {
     void BVExtractConcreteFunctor::operator () (EvalMap Args,
                                                 ConcreteValueBase* Result)
     {
+        if (UNLIKELY(WideBV::IsWide(ArgType->As<ESBVType>()->GetSize()))) {
+            auto Store = ArgType->As<ESBVType>()->GetStore();
+            auto ResultLimbs = WideBV::Extract(Store->Get(Args[0]->GetValue()), High, Low);
+            if (WideBV::IsWide(RetType->As<ESBVType>()->GetSize())) {
+                new (Result) ConcreteValueBase(RetType, Store->Intern(ResultLimbs));
+            } else {
+                new (Result) ConcreteValueBase(RetType, (int64)ResultLimbs[0]);
+            }
+            return;
+        }
+
         uint64 ResultBits = (uint64)Args[0]->GetValue();
         ResultBits &= ExtractMask;
         if (ExtractShift != 0) {
@@ -1924,6 +2641,19 @@ namespace ESolverBVLogic {
         new (Result) ConcreteValueBase(RetType, ResultBits);
     }
 
+    void BVExtractConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                                 int64* Result, uint8* Exceptions)
+    {
+        if (UNLIKELY(WideBV::IsWide(ArgType->As<ESBVType>()->GetSize()))) {
+            ConcFunctorBase::EvaluateBatch(Args, NumArgs, NumLanes, Result, Exceptions);
+            return;
+        }
+        const uint64* Arg = (const uint64*)Args[0];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = ((Arg[i] & ExtractMask) >> ExtractShift) & ResultMask;
+        }
+    }
+
     string BVExtractConcreteFunctor::ToString() const
     {
         return "BVExtractConcreteFunctor";
@@ -2014,6 +2744,45 @@ namespace ESolver {
         }
     }
 
+    inline RewriteFacts BVLogic::MakeRewriteFacts(const string& Name,
+                                                  const ESFixedTypeBase* Type) const
+    {
+        // Built from literals, the handles of wide values
+        // cannot be made up from an int64
+        const uint32 NumBits = Type->As<ESBVType>()->GetSize();
+        auto Zero = Solver->CreateValue(Type, "#b" + string(NumBits, '0'));
+        auto One = Solver->CreateValue(Type, "#b" + string(NumBits - 1, '0') + "1");
+        auto Ones = Solver->CreateValue(Type, "#b" + string(NumBits, '1'));
+
+        RewriteFacts Facts;
+        if (Name == "bvnot" || Name == "bvneg") {
+            Facts.Involutive = true;
+        } else if (Name == "bvand") {
+            Facts.LeftIdentity = Facts.RightIdentity = Ones;
+            Facts.LeftAnnihilator = Facts.RightAnnihilator = Zero;
+            Facts.Idempotent = Facts.Associative = true;
+        } else if (Name == "bvor") {
+            Facts.LeftIdentity = Facts.RightIdentity = Zero;
+            Facts.LeftAnnihilator = Facts.RightAnnihilator = Ones;
+            Facts.Idempotent = Facts.Associative = true;
+        } else if (Name == "bvadd" || Name == "bvxor") {
+            Facts.LeftIdentity = Facts.RightIdentity = Zero;
+            Facts.Associative = true;
+        } else if (Name == "bvmul") {
+            Facts.LeftIdentity = Facts.RightIdentity = One;
+            Facts.LeftAnnihilator = Facts.RightAnnihilator = Zero;
+            Facts.Associative = true;
+        } else if (Name == "bvudiv") {
+            Facts.RightIdentity = One;
+        } else if (Name == "bvsub") {
+            Facts.RightIdentity = Zero;
+        } else if (Name == "bvshl" || Name == "bvlshr" || Name == "bvashr") {
+            Facts.RightIdentity = Zero;
+            Facts.LeftAnnihilator = Zero;
+        }
+        return Facts;
+    }
+
     inline bool BVLogic::InstantiateOperator(const string& Name,
                                              const vector<const ESFixedTypeBase*>& DomainTypes)
     {
@@ -2035,82 +2804,101 @@ namespace ESolver {
 
         if (Name == "bvnot") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvnot", UnOpArgs, Type,
                                    new BVNotSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVNotConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   false, true);
+                                   MakeBVUnaryConcreteFunctor<BVNotConcreteFunctor, BVNativeNot>(Type,
+                                                                                                 Solver->CreateBoolType()),
+                                   false, true, 1, &Facts);
             return true;
         }
         if (Name == "bvand") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvand", BinOpArgs, Type,
                                    new BVAndSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVAndConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   true, true);
+                                   MakeBVBinaryConcreteFunctor<BVAndConcreteFunctor, BVNativeAnd>(Type,
+                                                                                                  Solver->CreateBoolType()),
+                                   true, true, 1, &Facts);
             return true;
         }
         if (Name == "bvor") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvor", BinOpArgs, Type,
                                    new BVOrSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVOrConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   true, true);
+                                   MakeBVBinaryConcreteFunctor<BVOrConcreteFunctor, BVNativeOr>(Type,
+                                                                                                Solver->CreateBoolType()),
+                                   true, true, 1, &Facts);
             return true;
         }
         if (Name == "bvneg") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvneg", UnOpArgs, Type,
                                    new BVNegSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVNegConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   false, true);
+                                   MakeBVUnaryConcreteFunctor<BVNegConcreteFunctor, BVNativeNeg>(Type,
+                                                                                                 Solver->CreateBoolType()),
+                                   false, true, 1, &Facts);
             return true;
         }
         if (Name == "bvadd") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvadd", BinOpArgs, Type,
                                    new BVAddSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVAddConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   true, true);
+                                   MakeBVBinaryConcreteFunctor<BVAddConcreteFunctor, BVNativeAdd>(Type,
+                                                                                                  Solver->CreateBoolType()),
+                                   true, true, 1, &Facts);
             return true;
         }
         if (Name == "bvmul") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvmul", BinOpArgs, Type,
                                    new BVMulSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVMulConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   true, true);
+                                   MakeBVBinaryConcreteFunctor<BVMulConcreteFunctor, BVNativeMul>(Type,
+                                                                                                  Solver->CreateBoolType()),
+                                   true, true, 1, &Facts);
             return true;
         }
         if (Name == "bvudiv") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvudiv", BinOpArgs, Type,
                                    new BVUSDivSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVUSDivConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   false, true);
+                                   MakeBVBinaryConcreteFunctor<BVUSDivConcreteFunctor, BVNativeUSDiv>(Type,
+                                                                                                      Solver->CreateBoolType()),
+                                   false, true, 1, &Facts);
             return true;
         }
         if (Name == "bvurem") {
             CheckType(DomainTypes);
             Solver->CreateFunction("bvurem", BinOpArgs, Type,
                                    new BVUSRemSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVUSRemConcreteFunctor(Type, Solver->CreateBoolType()),
+                                   MakeBVBinaryConcreteFunctor<BVUSRemConcreteFunctor, BVNativeUSRem>(Type,
+                                                                                                      Solver->CreateBoolType()),
                                    false, true);
             return true;
         }
         if (Name == "bvshl") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvshl", BinOpArgs, Type,
                                    new BVShlSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVShlConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   false, true);
+                                   MakeBVBinaryConcreteFunctor<BVShlConcreteFunctor, BVNativeShl>(Type,
+                                                                                                  Solver->CreateBoolType()),
+                                   false, true, 1, &Facts);
             return true;
         }
         if (Name == "bvlshr") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvlshr", BinOpArgs, Type,
                                    new BVLShrSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVLShrConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   false, true);
+                                   MakeBVBinaryConcreteFunctor<BVLShrConcreteFunctor, BVNativeLShr>(Type,
+                                                                                                    Solver->CreateBoolType()),
+                                   false, true, 1, &Facts);
             return true;
         }
         if (Name == "bvult") {
@@ -2125,7 +2913,8 @@ namespace ESolver {
             CheckType(DomainTypes);
             Solver->CreateFunction("bvnand", BinOpArgs, Type,
                                    new BVNandSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVNandConcreteFunctor(Type, Solver->CreateBoolType()),
+                                   MakeBVBinaryConcreteFunctor<BVNandConcreteFunctor, BVNativeNand>(Type,
+                                                                                                    Solver->CreateBoolType()),
                                    true, true);
             return true;
         }
@@ -2133,23 +2922,27 @@ namespace ESolver {
             CheckType(DomainTypes);
             Solver->CreateFunction("bvnor", BinOpArgs, Type,
                                    new BVNorSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVNorConcreteFunctor(Type, Solver->CreateBoolType()),
+                                   MakeBVBinaryConcreteFunctor<BVNorConcreteFunctor, BVNativeNor>(Type,
+                                                                                                  Solver->CreateBoolType()),
                                    true, true);
             return true;
         }
         if (Name == "bvxor") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvxor", BinOpArgs, Type,
                                    new BVXorSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVXorConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   true, true);
+                                   MakeBVBinaryConcreteFunctor<BVXorConcreteFunctor, BVNativeXor>(Type,
+                                                                                                  Solver->CreateBoolType()),
+                                   true, true, 1, &Facts);
             return true;
         }
         if (Name == "bvxnor") {
             CheckType(DomainTypes);
             Solver->CreateFunction("bvxnor", BinOpArgs, Type,
                                    new BVXNorSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVXNorConcreteFunctor(Type, Solver->CreateBoolType()),
+                                   MakeBVBinaryConcreteFunctor<BVXNorConcreteFunctor, BVNativeXNor>(Type,
+                                                                                                    Solver->CreateBoolType()),
                                    true, true);
             return true;
         }
@@ -2161,17 +2954,20 @@ namespace ESolver {
         }
         if (Name == "bvsub") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvsub", BinOpArgs, Type,
                                    new BVSubSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVSubConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   false, true);
+                                   MakeBVBinaryConcreteFunctor<BVSubConcreteFunctor, BVNativeSub>(Type,
+                                                                                                  Solver->CreateBoolType()),
+                                   false, true, 1, &Facts);
             return true;
         }
         if (Name == "bvsdiv") {
             CheckType(DomainTypes);
             Solver->CreateFunction("bvsdiv", BinOpArgs, Type,
                                    new BVSDivSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVSDivConcreteFunctor(Type, Solver->CreateBoolType()),
+                                   MakeBVBinaryConcreteFunctor<BVSDivConcreteFunctor, BVNativeSDiv>(Type,
+                                                                                                    Solver->CreateBoolType()),
                                    false, true);
             return true;
         }
@@ -2179,7 +2975,8 @@ namespace ESolver {
             CheckType(DomainTypes);
             Solver->CreateFunction("bvsrem", BinOpArgs, Type,
                                    new BVSRemSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVSRemConcreteFunctor(Type, Solver->CreateBoolType()),
+                                   MakeBVBinaryConcreteFunctor<BVSRemConcreteFunctor, BVNativeSRem>(Type,
+                                                                                                    Solver->CreateBoolType()),
                                    false, true);
             return true;
         }
@@ -2190,10 +2987,12 @@ namespace ESolver {
 
         if (Name == "bvashr") {
             CheckType(DomainTypes);
+            auto Facts = MakeRewriteFacts(Name, Type);
             Solver->CreateFunction("bvashr", BinOpArgs, Type,
                                    new BVAShrSymbolicFunctor(Type, Solver->CreateBoolType()),
-                                   new BVAShrConcreteFunctor(Type, Solver->CreateBoolType()),
-                                   false, true);
+                                   MakeBVBinaryConcreteFunctor<BVAShrConcreteFunctor, BVNativeAShr>(Type,
+                                                                                                    Solver->CreateBoolType()),
+                                   false, true, 1, &Facts);
             return true;
         }
         if (Name == "bvule") {
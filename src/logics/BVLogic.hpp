@@ -45,6 +45,7 @@
 #include "../logics/ESolverLogic.hpp"
 #include "../z3interface/Z3Objects.hpp"
 #include "../descriptions/FunctorBase.hpp"
+#include "../values/WideBitVector.hpp"
 
 using namespace ESolver; 
 
@@ -56,10 +57,17 @@ namespace ESolverBVLogic {
         const ESFixedTypeBase* Type;
         const ESFixedTypeBase* BoolType;
         uint64 Mask;
+        uint32 NumBits;
+        // Wider than 64 bits, values are handles into the store
+        bool Wide;
+        WideBVStore* Store;
         BVConcreteFunctor(const ESFixedTypeBase* Type, 
                           const ESFixedTypeBase* BoolType, 
                           uint64 UID);
 
+        const WideBVLimbs& WideArg(EvalMap Args, uint32 Index) const;
+        void SetWideResult(ConcreteValueBase* Result, const WideBVLimbs& Limbs) const;
+
     public:
         BVConcreteFunctor(const ESFixedTypeBase* Type,
                           const ESFixedTypeBase* BoolType);
@@ -90,6 +98,8 @@ namespace ESolverBVLogic {
         virtual ~BVAddConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -113,6 +123,8 @@ namespace ESolverBVLogic {
         virtual ~BVSubConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -136,6 +148,8 @@ namespace ESolverBVLogic {
         virtual ~BVAndConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -159,6 +173,8 @@ namespace ESolverBVLogic {
         virtual ~BVOrConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -183,6 +199,8 @@ namespace ESolverBVLogic {
         virtual ~BVNotConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -206,6 +224,8 @@ namespace ESolverBVLogic {
         virtual ~BVNandConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -229,6 +249,8 @@ namespace ESolverBVLogic {
         virtual ~BVNorConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -252,6 +274,8 @@ namespace ESolverBVLogic {
         virtual ~BVXorConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -275,6 +299,8 @@ namespace ESolverBVLogic {
         virtual ~BVXNorConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -298,6 +324,8 @@ namespace ESolverBVLogic {
         virtual ~BVShlConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -320,6 +348,8 @@ namespace ESolverBVLogic {
         virtual ~BVAShrConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -343,6 +373,8 @@ namespace ESolverBVLogic {
         virtual ~BVLShrConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -366,6 +398,8 @@ namespace ESolverBVLogic {
         virtual ~BVNegConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -389,6 +423,8 @@ namespace ESolverBVLogic {
         virtual ~BVUSLEConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -412,6 +448,8 @@ namespace ESolverBVLogic {
         virtual ~BVUSGTConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -435,6 +473,8 @@ namespace ESolverBVLogic {
         virtual ~BVUSDivConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -458,6 +498,8 @@ namespace ESolverBVLogic {
         virtual ~BVSDivConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -481,6 +523,8 @@ namespace ESolverBVLogic {
         virtual ~BVUSRemConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -504,6 +548,8 @@ namespace ESolverBVLogic {
         virtual ~BVSRemConcreteFunctor();
         virtual void operator () (EvalMap Args,
                              ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -527,6 +573,8 @@ namespace ESolverBVLogic {
         virtual ~BVMulConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -551,6 +599,8 @@ namespace ESolverBVLogic {
         virtual ~BVToBoolConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -586,6 +636,8 @@ namespace ESolverBVLogic {
         virtual ~BVToSIntConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
 
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
@@ -621,6 +673,8 @@ namespace ESolverBVLogic {
         virtual ~BVToUSIntConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -644,6 +698,8 @@ namespace ESolverBVLogic {
         virtual ~BVUSLTConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;        
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -667,6 +723,8 @@ namespace ESolverBVLogic {
         virtual ~BVUSGEConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;        
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -690,6 +748,8 @@ namespace ESolverBVLogic {
         virtual ~BVSLEConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;        
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -713,6 +773,8 @@ namespace ESolverBVLogic {
         virtual ~BVSLTConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;        
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -736,6 +798,8 @@ namespace ESolverBVLogic {
         virtual ~BVSGEConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;        
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -759,6 +823,8 @@ namespace ESolverBVLogic {
         virtual ~BVSGTConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -798,6 +864,8 @@ namespace ESolverBVLogic {
         virtual ~BVConcatConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -853,6 +921,8 @@ namespace ESolverBVLogic {
 
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
 
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
@@ -891,6 +961,8 @@ namespace ESolverBVLogic {
         virtual ~BVRedOrConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -915,6 +987,8 @@ namespace ESolverBVLogic {
         virtual ~BVRedAndConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -940,6 +1014,9 @@ namespace ESolver {
     private:
         static set<string> ReservedNames;
 
+        inline RewriteFacts MakeRewriteFacts(const string& Name,
+                                             const ESFixedTypeBase* Type) const;
+
     public:
         BVLogic(ESolver* Solver);
         virtual ~BVLogic();
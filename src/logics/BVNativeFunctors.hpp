@@ -0,0 +1,400 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Concrete BV functors specialized for 8, 16, 32 and 64 bit widths
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "BVLogic.hpp"
+#include "../descriptions/ESType.hpp"
+#include "../values/ConcreteValueBase.hpp"
+#include <type_traits>
+
+namespace ESolverBVLogic {
+
+    // Sign extends the low (64 - Shift) bits of Value
+    static inline int64 SignExtend(int64 Value, uint32 Shift)
+    {
+        return (int64)((uint64)Value << Shift) >> Shift;
+    }
+
+    // Truncating division of sign extended values, Arg2 != 0.
+    // Computed on the magnitudes so that INT64_MIN / -1 wraps
+    static inline int64 SignedDivide(int64 Arg1, int64 Arg2)
+    {
+        if (Arg1 > 0 && Arg2 > 0) {
+            return (uint64)Arg1 / (uint64)Arg2;
+        } else if (Arg1 < 0 && Arg2 > 0) {
+            return -((int64)(((uint64)(-Arg1)) / (uint64)Arg2));
+        } else if (Arg1 > 0 && Arg2 < 0) {
+            return -((int64)((uint64)Arg1 / ((uint64)(-Arg2))));
+        } else {
+            return (uint64)(-Arg1) / (uint64)(-Arg2);
+        }
+    }
+
+    // Remainder with the sign of the dividend, Arg2 != 0
+    static inline int64 SignedRemainder(int64 Arg1, int64 Arg2)
+    {
+        if (Arg1 >= 0 && Arg2 > 0) {
+            return (uint64)Arg1 % (uint64)Arg2;
+        } else if (Arg1 < 0 && Arg2 > 0) {
+            return -((int64)(((uint64)(-Arg1)) % (uint64)Arg2));
+        } else if (Arg1 >= 0 && Arg2 < 0) {
+            return (int64)((uint64)Arg1 % ((uint64)(-Arg2)));
+        } else {
+            return -((int64)(((uint64)(-Arg1)) % ((uint64)(-Arg2))));
+        }
+    }
+
+    // Kernels on native unsigned types. Truncation to the type replaces
+    // the masking, and a cast to the signed type of the same width
+    // replaces the sign extension. Arithmetic is done on uint64 so that
+    // the promotion of narrow types to int cannot overflow
+    template <typename UT>
+    struct BVNativeKernelBase
+    {
+        typedef typename make_signed<UT>::type ST;
+        static const uint32 NumBits = sizeof(UT) * 8;
+    };
+
+    template <typename UT>
+    struct BVNativeAdd : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (UT)((uint64)A + (uint64)B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeSub : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (UT)((uint64)A - (uint64)B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeMul : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (UT)((uint64)A * (uint64)B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeAnd : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (UT)(A & B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeOr : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (UT)(A | B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeXor : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (UT)(A ^ B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeNand : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (UT)~(A & B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeNor : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (UT)~(A | B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeXNor : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (UT)~(A ^ B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeShl : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (B >= BVNativeShl::NumBits ? (UT)0 : (UT)((uint64)A << B));
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeLShr : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            return (B >= BVNativeLShr::NumBits ? (UT)0 : (UT)(A >> B));
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeAShr : public BVNativeKernelBase<UT>
+    {
+        typedef typename BVNativeKernelBase<UT>::ST ST;
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            const ST SA = (ST)A;
+            if (B >= BVNativeAShr::NumBits) {
+                return (SA < 0 ? (UT)~(UT)0 : (UT)0);
+            }
+            return (UT)((int64)SA >> B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeUSDiv : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            if (B == 0) {
+                Exception = true;
+                return (UT)~(UT)0;
+            }
+            return (UT)(A / B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeUSRem : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            if (B == 0) {
+                Exception = true;
+                return (UT)~(UT)0;
+            }
+            return (UT)(A % B);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeSDiv : public BVNativeKernelBase<UT>
+    {
+        typedef typename BVNativeKernelBase<UT>::ST ST;
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            const int64 SA = (ST)A;
+            const int64 SB = (ST)B;
+            if (SB == 0) {
+                Exception = true;
+                return (UT)(SA < 0 ? INT64_MIN : INT64_MAX);
+            }
+            return (UT)SignedDivide(SA, SB);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeSRem : public BVNativeKernelBase<UT>
+    {
+        typedef typename BVNativeKernelBase<UT>::ST ST;
+        static inline UT Apply(UT A, UT B, bool& Exception)
+        {
+            const int64 SA = (ST)A;
+            const int64 SB = (ST)B;
+            if (SB == 0) {
+                Exception = true;
+                return (UT)INT64_MAX;
+            }
+            return (UT)SignedRemainder(SA, SB);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeNeg : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, bool& Exception)
+        {
+            return (UT)(0 - (uint64)A);
+        }
+    };
+
+    template <typename UT>
+    struct BVNativeNot : public BVNativeKernelBase<UT>
+    {
+        static inline UT Apply(UT A, bool& Exception)
+        {
+            return (UT)~A;
+        }
+    };
+
+    // Derives from the generic functor of the same operator, so that
+    // the name and everything else stay the same; only the evaluation
+    // is replaced
+    template <typename UT, typename Base, template <typename> class Kernel>
+    class BVNativeBinaryConcreteFunctor : public Base
+    {
+    protected:
+        BVNativeBinaryConcreteFunctor(const ESFixedTypeBase* Type,
+                                      const ESFixedTypeBase* BoolType,
+                                      uint64 UID)
+            : Base(Type, BoolType, UID)
+        {
+            // Nothing here
+        }
+
+    public:
+        BVNativeBinaryConcreteFunctor(const ESFixedTypeBase* Type,
+                                      const ESFixedTypeBase* BoolType)
+            : Base(Type, BoolType)
+        {
+            // Nothing here
+        }
+
+        virtual ~BVNativeBinaryConcreteFunctor()
+        {
+            // Nothing here
+        }
+
+        virtual void operator () (EvalMap Args, ConcreteValueBase* Result) override
+        {
+            bool Exception = false;
+            UT ResultBits = Kernel<UT>::Apply((UT)Args[0]->GetValue(),
+                                              (UT)Args[1]->GetValue(), Exception);
+            if (Exception) {
+                ConcreteException = true;
+            }
+            new (Result) ConcreteValueBase(this->Type, (int64)(uint64)ResultBits);
+        }
+
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override
+        {
+            const int64* Arg1 = Args[0];
+            const int64* Arg2 = Args[1];
+            for (uint32 i = 0; i < NumLanes; ++i) {
+                bool Exception = false;
+                Result[i] = (uint64)Kernel<UT>::Apply((UT)Arg1[i], (UT)Arg2[i], Exception);
+                Exceptions[i] |= (uint8)(Exception ? BATCH_LANE_EXCEPTION : 0);
+            }
+        }
+
+        virtual ConcFunctorBase* Clone() const override
+        {
+            return new BVNativeBinaryConcreteFunctor(this->Type, this->BoolType, this->GetID());
+        }
+    };
+
+    template <typename UT, typename Base, template <typename> class Kernel>
+    class BVNativeUnaryConcreteFunctor : public Base
+    {
+    protected:
+        BVNativeUnaryConcreteFunctor(const ESFixedTypeBase* Type,
+                                     const ESFixedTypeBase* BoolType,
+                                     uint64 UID)
+            : Base(Type, BoolType, UID)
+        {
+            // Nothing here
+        }
+
+    public:
+        BVNativeUnaryConcreteFunctor(const ESFixedTypeBase* Type,
+                                     const ESFixedTypeBase* BoolType)
+            : Base(Type, BoolType)
+        {
+            // Nothing here
+        }
+
+        virtual ~BVNativeUnaryConcreteFunctor()
+        {
+            // Nothing here
+        }
+
+        virtual void operator () (EvalMap Args, ConcreteValueBase* Result) override
+        {
+            bool Exception = false;
+            UT ResultBits = Kernel<UT>::Apply((UT)Args[0]->GetValue(), Exception);
+            new (Result) ConcreteValueBase(this->Type, (int64)(uint64)ResultBits);
+        }
+
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override
+        {
+            const int64* Arg = Args[0];
+            for (uint32 i = 0; i < NumLanes; ++i) {
+                bool Exception = false;
+                Result[i] = (uint64)Kernel<UT>::Apply((UT)Arg[i], Exception);
+            }
+        }
+
+        virtual ConcFunctorBase* Clone() const override
+        {
+            return new BVNativeUnaryConcreteFunctor(this->Type, this->BoolType, this->GetID());
+        }
+    };
+
+    // Picks the native functor for the common widths and the
+    // generic, masking functor for all others
+    template <typename Base, template <typename> class Kernel>
+    static inline ConcFunctorBase* MakeBVBinaryConcreteFunctor(const ESFixedTypeBase* Type,
+                                                               const ESFixedTypeBase* BoolType)
+    {
+        switch (Type->As<ESBVType>()->GetSize()) {
+        case 8:
+            return new BVNativeBinaryConcreteFunctor<uint8, Base, Kernel>(Type, BoolType);
+        case 16:
+            return new BVNativeBinaryConcreteFunctor<uint16, Base, Kernel>(Type, BoolType);
+        case 32:
+            return new BVNativeBinaryConcreteFunctor<uint32, Base, Kernel>(Type, BoolType);
+        case 64:
+            return new BVNativeBinaryConcreteFunctor<uint64, Base, Kernel>(Type, BoolType);
+        default:
+            return new Base(Type, BoolType);
+        }
+    }
+
+    template <typename Base, template <typename> class Kernel>
+    static inline ConcFunctorBase* MakeBVUnaryConcreteFunctor(const ESFixedTypeBase* Type,
+                                                              const ESFixedTypeBase* BoolType)
+    {
+        switch (Type->As<ESBVType>()->GetSize()) {
+        case 8:
+            return new BVNativeUnaryConcreteFunctor<uint8, Base, Kernel>(Type, BoolType);
+        case 16:
+            return new BVNativeUnaryConcreteFunctor<uint16, Base, Kernel>(Type, BoolType);
+        case 32:
+            return new BVNativeUnaryConcreteFunctor<uint32, Base, Kernel>(Type, BoolType);
+        case 64:
+            return new BVNativeUnaryConcreteFunctor<uint64, Base, Kernel>(Type, BoolType);
+        default:
+            return new Base(Type, BoolType);
+        }
+    }
+
+} /* end namespace */
+
+//
+// BVNativeFunctors.hpp ends here
@@ -0,0 +1,153 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Implementation of affine normal forms of LIA terms
+//===----------------------------------------------------------------------===//
+
+#include "LIAAffineForm.hpp"
+#include "../descriptions/Operators.hpp"
+#include "../descriptions/ESType.hpp"
+#include <boost/functional/hash.hpp>
+
+namespace ESolver {
+
+    LIAAffineForm::LIAAffineForm()
+        : Constant((int64)0)
+    {
+        // Nothing here
+    }
+
+    LIAAffineForm::LIAAffineForm(int64 Constant)
+        : Constant(Constant)
+    {
+        // Nothing here
+    }
+
+    // Parameters get odd atoms, expressions are at least two byte
+    // aligned and get even ones
+    LIAAffineForm LIAAffineForm::OfParam(uint32 Position)
+    {
+        LIAAffineForm Retval;
+        Retval.Terms.push_back(make_pair((((uint64)Position) << 1) | 1, (int64)1));
+        return Retval;
+    }
+
+    LIAAffineForm LIAAffineForm::OfAtom(const GenExpressionBase* Exp)
+    {
+        LIAAffineForm Retval;
+        Retval.Terms.push_back(make_pair((uint64)Exp, (int64)1));
+        return Retval;
+    }
+
+    bool LIAAffineForm::AddScaled(const LIAAffineForm& A, const LIAAffineForm& B,
+                                  int64 Scale, LIAAffineForm& Result)
+    {
+        int64 Scaled;
+        if (__builtin_mul_overflow(B.Constant, Scale, &Scaled) ||
+            __builtin_add_overflow(A.Constant, Scaled, &Result.Constant)) {
+            return false;
+        }
+
+        Result.Terms.clear();
+        Result.Terms.reserve(A.Terms.size() + B.Terms.size());
+        auto it1 = A.Terms.begin();
+        auto it2 = B.Terms.begin();
+        while (it1 != A.Terms.end() || it2 != B.Terms.end()) {
+            if (it2 == B.Terms.end() || (it1 != A.Terms.end() && it1->first < it2->first)) {
+                Result.Terms.push_back(*it1);
+                ++it1;
+                continue;
+            }
+            if (__builtin_mul_overflow(it2->second, Scale, &Scaled)) {
+                return false;
+            }
+            if (it1 == A.Terms.end() || it2->first < it1->first) {
+                if (Scaled != 0) {
+                    Result.Terms.push_back(make_pair(it2->first, Scaled));
+                }
+                ++it2;
+                continue;
+            }
+            int64 Coefficient;
+            if (__builtin_add_overflow(it1->second, Scaled, &Coefficient)) {
+                return false;
+            }
+            if (Coefficient != 0) {
+                Result.Terms.push_back(make_pair(it1->first, Coefficient));
+            }
+            ++it1;
+            ++it2;
+        }
+        return true;
+    }
+
+    bool LIAAffineForm::Apply(const InterpretedFuncOperator* Op,
+                              LIAAffineForm const* const* Args,
+                              LIAAffineForm& Result)
+    {
+        if (Op->GetEvalType()->GetBaseType() != BaseTypeInt) {
+            return false;
+        }
+
+        const string& Name = Op->GetName();
+        const uint32 Arity = Op->GetArity();
+
+        if (Name == "+" && Arity == 2) {
+            return AddScaled(*Args[0], *Args[1], (int64)1, Result);
+        } else if (Name == "-" && Arity == 2) {
+            return AddScaled(*Args[0], *Args[1], (int64)-1, Result);
+        } else if (Name == "-" && Arity == 1) {
+            return AddScaled(LIAAffineForm(), *Args[0], (int64)-1, Result);
+        } else if (Name == "*" && Arity == 2) {
+            if (Args[0]->IsConstant()) {
+                return AddScaled(LIAAffineForm(), *Args[1], Args[0]->Constant, Result);
+            } else if (Args[1]->IsConstant()) {
+                return AddScaled(LIAAffineForm(), *Args[0], Args[1]->Constant, Result);
+            }
+        }
+        return false;
+    }
+
+    bool LIAAffineForm::IsConstant() const
+    {
+        return Terms.empty();
+    }
+
+    bool LIAAffineForm::operator == (const LIAAffineForm& Other) const
+    {
+        return (Constant == Other.Constant && Terms == Other.Terms);
+    }
+
+    uint64 LIAAffineForm::Hash() const
+    {
+        uint64 Retval = (uint64)Constant;
+        for (auto const& Term : Terms) {
+            boost::hash_combine(Retval, Term.first);
+            boost::hash_combine(Retval, Term.second);
+        }
+        return Retval;
+    }
+
+    string LIAAffineForm::ToString() const
+    {
+        ostringstream sstr;
+        for (auto const& Term : Terms) {
+            sstr << Term.second << "*";
+            if ((Term.first & 1) != 0) {
+                sstr << "_arg_" << (Term.first >> 1);
+            } else {
+                sstr << "<" << (const void*)Term.first << ">";
+            }
+            sstr << " + ";
+        }
+        sstr << Constant;
+        return sstr.str();
+    }
+
+} /* End namespace */
+
+//
+// LIAAffineForm.cpp ends here
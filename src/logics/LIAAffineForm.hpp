@@ -0,0 +1,64 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Affine normal forms of LIA terms
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "../common/ESolverForwardDecls.hpp"
+
+namespace ESolver {
+
+    // An integer term as a linear combination of atoms plus a constant.
+    // Atoms are formal parameters and terms that are not affine
+    // themselves, the latter are identified by the expression object.
+    // Two terms with equal forms are equal, so that an enumerator
+    // needs to build only one term per form
+    class LIAAffineForm
+    {
+    private:
+        // Sorted by atom, without zero coefficients
+        vector<pair<uint64, int64>> Terms;
+        int64 Constant;
+
+        // Computes A + Scale * B, false on overflow
+        static bool AddScaled(const LIAAffineForm& A, const LIAAffineForm& B,
+                              int64 Scale, LIAAffineForm& Result);
+
+    public:
+        LIAAffineForm();
+        explicit LIAAffineForm(int64 Constant);
+
+        static LIAAffineForm OfParam(uint32 Position);
+        static LIAAffineForm OfAtom(const GenExpressionBase* Exp);
+
+        // The form of Op applied to arguments of the given forms.
+        // Returns false if the application is not affine, or if a
+        // coefficient overflows
+        static bool Apply(const InterpretedFuncOperator* Op,
+                          LIAAffineForm const* const* Args,
+                          LIAAffineForm& Result);
+
+        bool IsConstant() const;
+        bool operator == (const LIAAffineForm& Other) const;
+        uint64 Hash() const;
+        string ToString() const;
+    };
+
+    class LIAAffineFormHasher
+    {
+    public:
+        inline uint64 operator () (const LIAAffineForm& Form) const
+        {
+            return Form.Hash();
+        }
+    };
+
+} /* End namespace */
+
+//
+// LIAAffineForm.hpp ends here
@@ -43,6 +43,7 @@
 #include "../z3interface/TheoremProver.hpp"
 #include "../values/ConcreteValueBase.hpp"
 #include "../descriptions/ESType.hpp"
+#include "../descriptions/Operators.hpp"
 #include "../solvers/ESolver.hpp"
 
 namespace ESolverLIALogic {
@@ -95,7 +96,22 @@ namespace ESolverLIALogic {
     void AddConcreteFunctor::operator() (EvalMap Args,
                                          ConcreteValueBase* Result)
     {
-        new (Result) ConcreteValueBase(IntType, Args[0]->GetValue() + Args[1]->GetValue());
+        int64 Value;
+        if (UNLIKELY(__builtin_add_overflow(Args[0]->GetValue(), Args[1]->GetValue(), &Value))) {
+            ConcreteOverflow = true;
+        }
+        new (Result) ConcreteValueBase(IntType, Value);
+    }
+
+    void AddConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                           int64* Result, uint8* Exceptions)
+    {
+        const int64* Arg1 = Args[0];
+        const int64* Arg2 = Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            bool Overflow = __builtin_add_overflow(Arg1[i], Arg2[i], &Result[i]);
+            Exceptions[i] |= (uint8)(Overflow ? BATCH_LANE_OVERFLOW : 0);
+        }
     }
 
     string AddConcreteFunctor::ToString() const
@@ -138,7 +154,22 @@ namespace ESolverLIALogic {
     void SubConcreteFunctor::operator () (EvalMap Args,
                                           ConcreteValueBase* Result)
     {
-        new (Result) ConcreteValueBase(IntType, Args[0]->GetValue() - Args[1]->GetValue());
+        int64 Value;
+        if (UNLIKELY(__builtin_sub_overflow(Args[0]->GetValue(), Args[1]->GetValue(), &Value))) {
+            ConcreteOverflow = true;
+        }
+        new (Result) ConcreteValueBase(IntType, Value);
+    }
+
+    void SubConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                           int64* Result, uint8* Exceptions)
+    {
+        const int64* Arg1 = Args[0];
+        const int64* Arg2 = Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            bool Overflow = __builtin_sub_overflow(Arg1[i], Arg2[i], &Result[i]);
+            Exceptions[i] |= (uint8)(Overflow ? BATCH_LANE_OVERFLOW : 0);
+        }
     }
 
     string SubConcreteFunctor::ToString() const
@@ -181,7 +212,21 @@ namespace ESolverLIALogic {
     void MinusConcreteFunctor::operator () (EvalMap Args,
                                             ConcreteValueBase* Result)
     {
-        new (Result) ConcreteValueBase(IntType, (- Args[0]->GetValue()));
+        int64 Value;
+        if (UNLIKELY(__builtin_sub_overflow((int64)0, Args[0]->GetValue(), &Value))) {
+            ConcreteOverflow = true;
+        }
+        new (Result) ConcreteValueBase(IntType, Value);
+    }
+
+    void MinusConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                             int64* Result, uint8* Exceptions)
+    {
+        const int64* Arg = Args[0];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            bool Overflow = __builtin_sub_overflow((int64)0, Arg[i], &Result[i]);
+            Exceptions[i] |= (uint8)(Overflow ? BATCH_LANE_OVERFLOW : 0);
+        }
     }
 
     string MinusConcreteFunctor::ToString() const
@@ -224,7 +269,22 @@ namespace ESolverLIALogic {
     void MulConcreteFunctor::operator () (EvalMap Args,
                                           ConcreteValueBase* Result)
     {
-        new (Result) ConcreteValueBase(IntType, Args[0]->GetValue() * Args[1]->GetValue());
+        int64 Value;
+        if (UNLIKELY(__builtin_mul_overflow(Args[0]->GetValue(), Args[1]->GetValue(), &Value))) {
+            ConcreteOverflow = true;
+        }
+        new (Result) ConcreteValueBase(IntType, Value);
+    }
+
+    void MulConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                           int64* Result, uint8* Exceptions)
+    {
+        const int64* Arg1 = Args[0];
+        const int64* Arg2 = Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            bool Overflow = __builtin_mul_overflow(Arg1[i], Arg2[i], &Result[i]);
+            Exceptions[i] |= (uint8)(Overflow ? BATCH_LANE_OVERFLOW : 0);
+        }
     }
 
     string MulConcreteFunctor::ToString() const
@@ -271,6 +331,16 @@ namespace ESolverLIALogic {
                                        Args[0]->GetValue() > Args[1]->GetValue() ? (int64)1 : (int64)0);
     }
 
+    void GTConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                          int64* Result, uint8* Exceptions)
+    {
+        const int64* Arg1 = Args[0];
+        const int64* Arg2 = Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] > Arg2[i] ? 1 : 0;
+        }
+    }
+
     string GTConcreteFunctor::ToString() const
     {
         return "GTConcreteFunctor";
@@ -315,6 +385,16 @@ namespace ESolverLIALogic {
                                        Args[0]->GetValue() >= Args[1]->GetValue() ? (int64)1 : (int64)0);
     }
 
+    void GEConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                          int64* Result, uint8* Exceptions)
+    {
+        const int64* Arg1 = Args[0];
+        const int64* Arg2 = Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] >= Arg2[i] ? 1 : 0;
+        }
+    }
+
     string GEConcreteFunctor::ToString() const
     {
         return "GEConcreteFunctor";
@@ -359,6 +439,16 @@ namespace ESolverLIALogic {
                                        Args[0]->GetValue() < Args[1]->GetValue() ? (int64)1 : (int64)0);
     }
 
+    void LTConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                          int64* Result, uint8* Exceptions)
+    {
+        const int64* Arg1 = Args[0];
+        const int64* Arg2 = Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] < Arg2[i] ? 1 : 0;
+        }
+    }
+
     string LTConcreteFunctor::ToString() const
     {
         return "LTConcreteFunctor";
@@ -403,6 +493,16 @@ namespace ESolverLIALogic {
                                        Args[0]->GetValue() <= Args[1]->GetValue() ? (int64)1 : (int64)0);
     }
 
+    void LEConcreteFunctor::EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                          int64* Result, uint8* Exceptions)
+    {
+        const int64* Arg1 = Args[0];
+        const int64* Arg2 = Args[1];
+        for (uint32 i = 0; i < NumLanes; ++i) {
+            Result[i] = Arg1[i] <= Arg2[i] ? 1 : 0;
+        }
+    }
+
     string LEConcreteFunctor::ToString() const
     {
         return "GEConcreteFunctor";
@@ -463,25 +563,43 @@ namespace ESolver {
         UnOpArgTypes[0] = BinOpArgTypes[0] = 
             BinOpArgTypes[1] = Solver->CreateIntType();
 
+        auto Zero = Solver->CreateValue(IntType, (int64)0);
+        auto One = Solver->CreateValue(IntType, (int64)1);
+
+        RewriteFacts AddFacts;
+        AddFacts.LeftIdentity = AddFacts.RightIdentity = Zero;
+        AddFacts.Associative = true;
+
+        RewriteFacts SubFacts;
+        SubFacts.RightIdentity = Zero;
+
+        RewriteFacts MinusFacts;
+        MinusFacts.Involutive = true;
+
+        RewriteFacts MulFacts;
+        MulFacts.LeftIdentity = MulFacts.RightIdentity = One;
+        MulFacts.LeftAnnihilator = MulFacts.RightAnnihilator = Zero;
+        MulFacts.Associative = true;
+
         Solver->CreateFunction("+", BinOpArgTypes, IntType,
                                new AddSymbolicFunctor(IntType, BoolType),
                                new AddConcreteFunctor(IntType, BoolType),
-                               true, true);
+                               true, true, 1, &AddFacts);
 
         Solver->CreateFunction("-", BinOpArgTypes, IntType,
                                new SubSymbolicFunctor(IntType, BoolType), 
                                new SubConcreteFunctor(IntType, BoolType), 
-                               false, true);
+                               false, true, 1, &SubFacts);
 
         Solver->CreateFunction("-", UnOpArgTypes, IntType,
                                new MinusSymbolicFunctor(IntType, BoolType), 
                                new MinusConcreteFunctor(IntType, BoolType), 
-                               false, true);
+                               false, true, 1, &MinusFacts);
 
         Solver->CreateFunction("*", BinOpArgTypes, IntType,
                                new MulSymbolicFunctor(IntType, BoolType), 
                                new MulConcreteFunctor(IntType, BoolType), 
-                               true, true);
+                               true, true, 1, &MulFacts);
 
         Solver->CreateFunction(">", BinOpArgTypes, BoolType,
                                new GTSymbolicFunctor(IntType, BoolType), 
@@ -89,6 +89,8 @@ namespace ESolverLIALogic {
         virtual ~AddConcreteFunctor();
         virtual void operator()(EvalMap Args,
                                 ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -112,6 +114,8 @@ namespace ESolverLIALogic {
         virtual ~SubConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -135,6 +139,8 @@ namespace ESolverLIALogic {
         virtual ~MinusConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;        
     };
@@ -158,6 +164,8 @@ namespace ESolverLIALogic {
         virtual ~MulConcreteFunctor();
         virtual void operator () (EvalMap Args,
                                   ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -181,6 +189,8 @@ namespace ESolverLIALogic {
         virtual ~GTConcreteFunctor();
         virtual void operator() (EvalMap Args,
                                  ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -204,6 +214,8 @@ namespace ESolverLIALogic {
         virtual ~GEConcreteFunctor();
         virtual void operator() (EvalMap Args,
                                  ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -228,6 +240,8 @@ namespace ESolverLIALogic {
         virtual ~LTConcreteFunctor();
         virtual void operator() (EvalMap Args,
                                  ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
@@ -251,6 +265,8 @@ namespace ESolverLIALogic {
         virtual ~LEConcreteFunctor();
         virtual void operator() (EvalMap Args,
                                  ConcreteValueBase* Result) override;
+        virtual void EvaluateBatch(BatchEvalMap Args, uint32 NumArgs, uint32 NumLanes,
+                                   int64* Result, uint8* Exceptions) override;
         virtual string ToString() const override;
         virtual ConcFunctorBase* Clone() const override;
     };
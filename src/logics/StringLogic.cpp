@@ -0,0 +1,448 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Implementation of the theory of strings
+//===----------------------------------------------------------------------===//
+
+#include "StringLogic.hpp"
+#include "../z3interface/TheoremProver.hpp"
+#include "../values/ConcreteValueBase.hpp"
+#include "../values/StringStore.hpp"
+#include "../descriptions/ESType.hpp"
+#include "../descriptions/Operators.hpp"
+#include "../solvers/ESolver.hpp"
+#include <algorithm>
+
+namespace ESolverStringLogic {
+
+    // (str.substr s i n): the empty string unless 0 <= i < |s| and 0 < n,
+    // otherwise at most n characters of s starting at i
+    static inline int64 Substring(StringStore* Store, int64 Str, int64 Offset, int64 Length)
+    {
+        const int64 StrLength = Store->GetLength(Str);
+        if (Offset < 0 || Offset >= StrLength || Length <= 0) {
+            return Store->GetEmpty();
+        }
+        Length = min(Length, StrLength - Offset);
+        return Store->Intern(Store->GetChars(Str) + Offset, (uint32)Length);
+    }
+
+    // (str.indexof s t i): the first position at or after i where t
+    // occurs in s, -1 if there is none or if i is not in [0, |s|]
+    static inline int64 IndexOf(const StringStore* Store, int64 Str, int64 Pattern, int64 Offset)
+    {
+        const int64 StrLength = Store->GetLength(Str);
+        if (Offset < 0 || Offset > StrLength) {
+            return -1;
+        }
+        const char* Begin = Store->GetChars(Str);
+        const char* End = Begin + StrLength;
+        const char* PatternBegin = Store->GetChars(Pattern);
+        const char* PatternEnd = PatternBegin + Store->GetLength(Pattern);
+        auto Match = search(Begin + Offset, End, PatternBegin, PatternEnd);
+        if (Match == End && PatternBegin != PatternEnd) {
+            return -1;
+        }
+        return Match - Begin;
+    }
+
+    StringConcreteFunctor::StringConcreteFunctor(const ESFixedTypeBase* StringType,
+                                                 const ESFixedTypeBase* IntType)
+        : ConcFunctorBase(), StringType(StringType), IntType(IntType),
+          Store(StringType->As<ESStringType>()->GetStore())
+    {
+        // Nothing here
+    }
+
+    StringConcreteFunctor::StringConcreteFunctor(const ESFixedTypeBase* StringType,
+                                                 const ESFixedTypeBase* IntType,
+                                                 uint64 UID)
+        : ConcFunctorBase(UID), StringType(StringType), IntType(IntType),
+          Store(StringType->As<ESStringType>()->GetStore())
+    {
+        // Nothing here
+    }
+
+    StringConcreteFunctor::~StringConcreteFunctor()
+    {
+        // Nothing here
+    }
+
+    StringSymbolicFunctor::StringSymbolicFunctor(const ESFixedTypeBase* StringType,
+                                                 const ESFixedTypeBase* IntType)
+        : SymbFunctorBase(), StringType(StringType), IntType(IntType)
+    {
+        // Nothing here
+    }
+
+    StringSymbolicFunctor::StringSymbolicFunctor(const ESFixedTypeBase* StringType,
+                                                 const ESFixedTypeBase* IntType,
+                                                 uint64 UID)
+        : SymbFunctorBase(UID), StringType(StringType), IntType(IntType)
+    {
+        // Nothing here
+    }
+
+    StringSymbolicFunctor::~StringSymbolicFunctor()
+    {
+        // Nothing here
+    }
+
+    ConcatConcreteFunctor::~ConcatConcreteFunctor()
+    {
+        // Nothing here
+    }
+
+    void ConcatConcreteFunctor::operator () (EvalMap Args,
+                                             ConcreteValueBase* Result)
+    {
+        const int64 First = Args[0]->GetValue();
+        const int64 Second = Args[1]->GetValue();
+        Store->BeginString();
+        Store->AppendChars(Store->GetChars(First), Store->GetLength(First));
+        Store->AppendChars(Store->GetChars(Second), Store->GetLength(Second));
+        new (Result) ConcreteValueBase(StringType, Store->CommitString());
+    }
+
+    string ConcatConcreteFunctor::ToString() const
+    {
+        return "ConcatConcreteFunctor";
+    }
+
+    ConcFunctorBase* ConcatConcreteFunctor::Clone() const
+    {
+        return new ConcatConcreteFunctor(StringType, IntType, GetID());
+    }
+
+    ConcatSymbolicFunctor::~ConcatSymbolicFunctor()
+    {
+        // Nothing here
+    }
+
+    SMTExpr ConcatSymbolicFunctor::operator () (TheoremProver* TP,
+                                                const vector<SMTExpr>& Args,
+                                                vector<SMTExpr>& Assumptions)
+    {
+        return TP->CreateStrConcatExpr(Args[0], Args[1]);
+    }
+
+    string ConcatSymbolicFunctor::ToString() const
+    {
+        return "ConcatSymbolicFunctor";
+    }
+
+    SymbFunctorBase* ConcatSymbolicFunctor::Clone() const
+    {
+        return new ConcatSymbolicFunctor(StringType, IntType, GetID());
+    }
+
+    SubstrConcreteFunctor::~SubstrConcreteFunctor()
+    {
+        // Nothing here
+    }
+
+    void SubstrConcreteFunctor::operator () (EvalMap Args,
+                                             ConcreteValueBase* Result)
+    {
+        new (Result) ConcreteValueBase(StringType, Substring(Store, Args[0]->GetValue(),
+                                                            Args[1]->GetValue(),
+                                                            Args[2]->GetValue()));
+    }
+
+    string SubstrConcreteFunctor::ToString() const
+    {
+        return "SubstrConcreteFunctor";
+    }
+
+    ConcFunctorBase* SubstrConcreteFunctor::Clone() const
+    {
+        return new SubstrConcreteFunctor(StringType, IntType, GetID());
+    }
+
+    SubstrSymbolicFunctor::~SubstrSymbolicFunctor()
+    {
+        // Nothing here
+    }
+
+    SMTExpr SubstrSymbolicFunctor::operator () (TheoremProver* TP,
+                                                const vector<SMTExpr>& Args,
+                                                vector<SMTExpr>& Assumptions)
+    {
+        return TP->CreateStrSubstrExpr(Args[0], Args[1], Args[2]);
+    }
+
+    string SubstrSymbolicFunctor::ToString() const
+    {
+        return "SubstrSymbolicFunctor";
+    }
+
+    SymbFunctorBase* SubstrSymbolicFunctor::Clone() const
+    {
+        return new SubstrSymbolicFunctor(StringType, IntType, GetID());
+    }
+
+    AtConcreteFunctor::~AtConcreteFunctor()
+    {
+        // Nothing here
+    }
+
+    void AtConcreteFunctor::operator () (EvalMap Args,
+                                         ConcreteValueBase* Result)
+    {
+        new (Result) ConcreteValueBase(StringType, Substring(Store, Args[0]->GetValue(),
+                                                            Args[1]->GetValue(),
+                                                            (int64)1));
+    }
+
+    string AtConcreteFunctor::ToString() const
+    {
+        return "AtConcreteFunctor";
+    }
+
+    ConcFunctorBase* AtConcreteFunctor::Clone() const
+    {
+        return new AtConcreteFunctor(StringType, IntType, GetID());
+    }
+
+    AtSymbolicFunctor::~AtSymbolicFunctor()
+    {
+        // Nothing here
+    }
+
+    SMTExpr AtSymbolicFunctor::operator () (TheoremProver* TP,
+                                            const vector<SMTExpr>& Args,
+                                            vector<SMTExpr>& Assumptions)
+    {
+        return TP->CreateStrAtExpr(Args[0], Args[1]);
+    }
+
+    string AtSymbolicFunctor::ToString() const
+    {
+        return "AtSymbolicFunctor";
+    }
+
+    SymbFunctorBase* AtSymbolicFunctor::Clone() const
+    {
+        return new AtSymbolicFunctor(StringType, IntType, GetID());
+    }
+
+    IndexOfConcreteFunctor::~IndexOfConcreteFunctor()
+    {
+        // Nothing here
+    }
+
+    void IndexOfConcreteFunctor::operator () (EvalMap Args,
+                                              ConcreteValueBase* Result)
+    {
+        new (Result) ConcreteValueBase(IntType, IndexOf(Store, Args[0]->GetValue(),
+                                                        Args[1]->GetValue(),
+                                                        Args[2]->GetValue()));
+    }
+
+    string IndexOfConcreteFunctor::ToString() const
+    {
+        return "IndexOfConcreteFunctor";
+    }
+
+    ConcFunctorBase* IndexOfConcreteFunctor::Clone() const
+    {
+        return new IndexOfConcreteFunctor(StringType, IntType, GetID());
+    }
+
+    IndexOfSymbolicFunctor::~IndexOfSymbolicFunctor()
+    {
+        // Nothing here
+    }
+
+    SMTExpr IndexOfSymbolicFunctor::operator () (TheoremProver* TP,
+                                                 const vector<SMTExpr>& Args,
+                                                 vector<SMTExpr>& Assumptions)
+    {
+        return TP->CreateStrIndexOfExpr(Args[0], Args[1], Args[2]);
+    }
+
+    string IndexOfSymbolicFunctor::ToString() const
+    {
+        return "IndexOfSymbolicFunctor";
+    }
+
+    SymbFunctorBase* IndexOfSymbolicFunctor::Clone() const
+    {
+        return new IndexOfSymbolicFunctor(StringType, IntType, GetID());
+    }
+
+    ReplaceConcreteFunctor::~ReplaceConcreteFunctor()
+    {
+        // Nothing here
+    }
+
+    void ReplaceConcreteFunctor::operator () (EvalMap Args,
+                                              ConcreteValueBase* Result)
+    {
+        const int64 Str = Args[0]->GetValue();
+        const int64 Pattern = Args[1]->GetValue();
+        const int64 Replacement = Args[2]->GetValue();
+        const int64 Position = IndexOf(Store, Str, Pattern, (int64)0);
+        if (Position < 0) {
+            new (Result) ConcreteValueBase(StringType, Str);
+            return;
+        }
+        // An empty pattern occurs at position zero
+        const uint32 Rest = Position + Store->GetLength(Pattern);
+        Store->BeginString();
+        Store->AppendChars(Store->GetChars(Str), Position);
+        Store->AppendChars(Store->GetChars(Replacement), Store->GetLength(Replacement));
+        Store->AppendChars(Store->GetChars(Str) + Rest, Store->GetLength(Str) - Rest);
+        new (Result) ConcreteValueBase(StringType, Store->CommitString());
+    }
+
+    string ReplaceConcreteFunctor::ToString() const
+    {
+        return "ReplaceConcreteFunctor";
+    }
+
+    ConcFunctorBase* ReplaceConcreteFunctor::Clone() const
+    {
+        return new ReplaceConcreteFunctor(StringType, IntType, GetID());
+    }
+
+    ReplaceSymbolicFunctor::~ReplaceSymbolicFunctor()
+    {
+        // Nothing here
+    }
+
+    SMTExpr ReplaceSymbolicFunctor::operator () (TheoremProver* TP,
+                                                 const vector<SMTExpr>& Args,
+                                                 vector<SMTExpr>& Assumptions)
+    {
+        return TP->CreateStrReplaceExpr(Args[0], Args[1], Args[2]);
+    }
+
+    string ReplaceSymbolicFunctor::ToString() const
+    {
+        return "ReplaceSymbolicFunctor";
+    }
+
+    SymbFunctorBase* ReplaceSymbolicFunctor::Clone() const
+    {
+        return new ReplaceSymbolicFunctor(StringType, IntType, GetID());
+    }
+
+    LenConcreteFunctor::~LenConcreteFunctor()
+    {
+        // Nothing here
+    }
+
+    void LenConcreteFunctor::operator () (EvalMap Args,
+                                          ConcreteValueBase* Result)
+    {
+        new (Result) ConcreteValueBase(IntType, (int64)Store->GetLength(Args[0]->GetValue()));
+    }
+
+    string LenConcreteFunctor::ToString() const
+    {
+        return "LenConcreteFunctor";
+    }
+
+    ConcFunctorBase* LenConcreteFunctor::Clone() const
+    {
+        return new LenConcreteFunctor(StringType, IntType, GetID());
+    }
+
+    LenSymbolicFunctor::~LenSymbolicFunctor()
+    {
+        // Nothing here
+    }
+
+    SMTExpr LenSymbolicFunctor::operator () (TheoremProver* TP,
+                                             const vector<SMTExpr>& Args,
+                                             vector<SMTExpr>& Assumptions)
+    {
+        return TP->CreateStrLenExpr(Args[0]);
+    }
+
+    string LenSymbolicFunctor::ToString() const
+    {
+        return "LenSymbolicFunctor";
+    }
+
+    SymbFunctorBase* LenSymbolicFunctor::Clone() const
+    {
+        return new LenSymbolicFunctor(StringType, IntType, GetID());
+    }
+
+} /* End ESolverStringLogic namespace */
+
+namespace ESolver {
+
+    using namespace ESolverStringLogic;
+
+    StringLogic::StringLogic(ESolver* Solver)
+        : ESolverLogic("StringLogic", Solver)
+    {
+        // Nothing here
+    }
+
+    StringLogic::~StringLogic()
+    {
+        // Nothing here
+    }
+
+    void StringLogic::Init()
+    {
+        auto StringType = Solver->CreateStringType();
+        auto IntType = Solver->CreateIntType();
+
+        vector<const ESFixedTypeBase*> ArgTypes;
+
+        auto Store = StringType->As<ESStringType>()->GetStore();
+        auto Empty = Solver->CreateValue(StringType, Store->GetEmpty());
+
+        RewriteFacts ConcatFacts;
+        ConcatFacts.LeftIdentity = ConcatFacts.RightIdentity = Empty;
+        ConcatFacts.Associative = true;
+
+        ArgTypes = { StringType, StringType };
+        Solver->CreateFunction("str.++", ArgTypes, StringType,
+                               new ConcatSymbolicFunctor(StringType, IntType),
+                               new ConcatConcreteFunctor(StringType, IntType),
+                               false, true, 1, &ConcatFacts);
+
+        ArgTypes = { StringType, IntType, IntType };
+        Solver->CreateFunction("str.substr", ArgTypes, StringType,
+                               new SubstrSymbolicFunctor(StringType, IntType),
+                               new SubstrConcreteFunctor(StringType, IntType),
+                               false, true);
+
+        ArgTypes = { StringType, IntType };
+        Solver->CreateFunction("str.at", ArgTypes, StringType,
+                               new AtSymbolicFunctor(StringType, IntType),
+                               new AtConcreteFunctor(StringType, IntType),
+                               false, true);
+
+        ArgTypes = { StringType, StringType, IntType };
+        Solver->CreateFunction("str.indexof", ArgTypes, IntType,
+                               new IndexOfSymbolicFunctor(StringType, IntType),
+                               new IndexOfConcreteFunctor(StringType, IntType),
+                               false, true);
+
+        ArgTypes = { StringType, StringType, StringType };
+        Solver->CreateFunction("str.replace", ArgTypes, StringType,
+                               new ReplaceSymbolicFunctor(StringType, IntType),
+                               new ReplaceConcreteFunctor(StringType, IntType),
+                               false, true);
+
+        ArgTypes = { StringType };
+        Solver->CreateFunction("str.len", ArgTypes, IntType,
+                               new LenSymbolicFunctor(StringType, IntType),
+                               new LenConcreteFunctor(StringType, IntType),
+                               false, true);
+    }
+
+} /* End namespace */
+
+//
+// StringLogic.cpp ends here
@@ -0,0 +1,211 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// The theory of strings, concrete and symbolic functors
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "../common/ESolverForwardDecls.hpp"
+#include "../logics/ESolverLogic.hpp"
+#include "../descriptions/FunctorBase.hpp"
+#include "../z3interface/Z3Objects.hpp"
+
+using namespace ESolver;
+
+namespace ESolverStringLogic {
+
+    // String values are handles into the StringStore of the String
+    // type. The functors only look at the values of their arguments,
+    // so that they also work on the untyped columns of batch evaluation
+    class StringConcreteFunctor : public ConcFunctorBase
+    {
+    protected:
+        const ESFixedTypeBase* StringType;
+        const ESFixedTypeBase* IntType;
+        StringStore* Store;
+
+        StringConcreteFunctor(const ESFixedTypeBase* StringType,
+                              const ESFixedTypeBase* IntType,
+                              uint64 UID);
+
+    public:
+        StringConcreteFunctor(const ESFixedTypeBase* StringType,
+                              const ESFixedTypeBase* IntType);
+        virtual ~StringConcreteFunctor();
+    };
+
+    class StringSymbolicFunctor : public SymbFunctorBase
+    {
+    protected:
+        const ESFixedTypeBase* StringType;
+        const ESFixedTypeBase* IntType;
+
+        StringSymbolicFunctor(const ESFixedTypeBase* StringType,
+                              const ESFixedTypeBase* IntType,
+                              uint64 UID);
+
+    public:
+        StringSymbolicFunctor(const ESFixedTypeBase* StringType,
+                              const ESFixedTypeBase* IntType);
+        virtual ~StringSymbolicFunctor();
+    };
+
+    class ConcatConcreteFunctor : public StringConcreteFunctor
+    {
+    public:
+        using StringConcreteFunctor::StringConcreteFunctor;
+        virtual ~ConcatConcreteFunctor();
+        virtual void operator () (EvalMap Args,
+                                  ConcreteValueBase* Result) override;
+        virtual string ToString() const override;
+        virtual ConcFunctorBase* Clone() const override;
+    };
+
+    class ConcatSymbolicFunctor : public StringSymbolicFunctor
+    {
+    public:
+        using StringSymbolicFunctor::StringSymbolicFunctor;
+        virtual ~ConcatSymbolicFunctor();
+        virtual SMTExpr operator () (TheoremProver* TP,
+                                     const vector<SMTExpr>& Args,
+                                     vector<SMTExpr>& Assumptions) override;
+        virtual string ToString() const override;
+        virtual SymbFunctorBase* Clone() const override;
+    };
+
+    class SubstrConcreteFunctor : public StringConcreteFunctor
+    {
+    public:
+        using StringConcreteFunctor::StringConcreteFunctor;
+        virtual ~SubstrConcreteFunctor();
+        virtual void operator () (EvalMap Args,
+                                  ConcreteValueBase* Result) override;
+        virtual string ToString() const override;
+        virtual ConcFunctorBase* Clone() const override;
+    };
+
+    class SubstrSymbolicFunctor : public StringSymbolicFunctor
+    {
+    public:
+        using StringSymbolicFunctor::StringSymbolicFunctor;
+        virtual ~SubstrSymbolicFunctor();
+        virtual SMTExpr operator () (TheoremProver* TP,
+                                     const vector<SMTExpr>& Args,
+                                     vector<SMTExpr>& Assumptions) override;
+        virtual string ToString() const override;
+        virtual SymbFunctorBase* Clone() const override;
+    };
+
+    class AtConcreteFunctor : public StringConcreteFunctor
+    {
+    public:
+        using StringConcreteFunctor::StringConcreteFunctor;
+        virtual ~AtConcreteFunctor();
+        virtual void operator () (EvalMap Args,
+                                  ConcreteValueBase* Result) override;
+        virtual string ToString() const override;
+        virtual ConcFunctorBase* Clone() const override;
+    };
+
+    class AtSymbolicFunctor : public StringSymbolicFunctor
+    {
+    public:
+        using StringSymbolicFunctor::StringSymbolicFunctor;
+        virtual ~AtSymbolicFunctor();
+        virtual SMTExpr operator () (TheoremProver* TP,
+                                     const vector<SMTExpr>& Args,
+                                     vector<SMTExpr>& Assumptions) override;
+        virtual string ToString() const override;
+        virtual SymbFunctorBase* Clone() const override;
+    };
+
+    class IndexOfConcreteFunctor : public StringConcreteFunctor
+    {
+    public:
+        using StringConcreteFunctor::StringConcreteFunctor;
+        virtual ~IndexOfConcreteFunctor();
+        virtual void operator () (EvalMap Args,
+                                  ConcreteValueBase* Result) override;
+        virtual string ToString() const override;
+        virtual ConcFunctorBase* Clone() const override;
+    };
+
+    class IndexOfSymbolicFunctor : public StringSymbolicFunctor
+    {
+    public:
+        using StringSymbolicFunctor::StringSymbolicFunctor;
+        virtual ~IndexOfSymbolicFunctor();
+        virtual SMTExpr operator () (TheoremProver* TP,
+                                     const vector<SMTExpr>& Args,
+                                     vector<SMTExpr>& Assumptions) override;
+        virtual string ToString() const override;
+        virtual SymbFunctorBase* Clone() const override;
+    };
+
+    class ReplaceConcreteFunctor : public StringConcreteFunctor
+    {
+    public:
+        using StringConcreteFunctor::StringConcreteFunctor;
+        virtual ~ReplaceConcreteFunctor();
+        virtual void operator () (EvalMap Args,
+                                  ConcreteValueBase* Result) override;
+        virtual string ToString() const override;
+        virtual ConcFunctorBase* Clone() const override;
+    };
+
+    class ReplaceSymbolicFunctor : public StringSymbolicFunctor
+    {
+    public:
+        using StringSymbolicFunctor::StringSymbolicFunctor;
+        virtual ~ReplaceSymbolicFunctor();
+        virtual SMTExpr operator () (TheoremProver* TP,
+                                     const vector<SMTExpr>& Args,
+                                     vector<SMTExpr>& Assumptions) override;
+        virtual string ToString() const override;
+        virtual SymbFunctorBase* Clone() const override;
+    };
+
+    class LenConcreteFunctor : public StringConcreteFunctor
+    {
+    public:
+        using StringConcreteFunctor::StringConcreteFunctor;
+        virtual ~LenConcreteFunctor();
+        virtual void operator () (EvalMap Args,
+                                  ConcreteValueBase* Result) override;
+        virtual string ToString() const override;
+        virtual ConcFunctorBase* Clone() const override;
+    };
+
+    class LenSymbolicFunctor : public StringSymbolicFunctor
+    {
+    public:
+        using StringSymbolicFunctor::StringSymbolicFunctor;
+        virtual ~LenSymbolicFunctor();
+        virtual SMTExpr operator () (TheoremProver* TP,
+                                     const vector<SMTExpr>& Args,
+                                     vector<SMTExpr>& Assumptions) override;
+        virtual string ToString() const override;
+        virtual SymbFunctorBase* Clone() const override;
+    };
+
+} /* End ESolverStringLogic namespace */
+
+namespace ESolver {
+
+    class StringLogic : public ESolverLogic
+    {
+    public:
+        StringLogic(ESolver* Solver);
+        virtual ~StringLogic();
+
+        virtual void Init() override;
+    };
+
+} /* End namespace */
+
+//
+// StringLogic.hpp ends here
@@ -595,7 +595,10 @@ namespace ESolver {
 
     void SynthLib2ESolver::VisitConstantGTerm(const ConstantGTerm* TheTerm)
     {
-        throw UnimplementedException((string)"(Constant <Type>) constructs are not yet supported");
+        TheTerm->GetSort()->Accept(this);
+        auto Type = SortStack.back();
+        SortStack.pop_back();
+        ProcessedGTermStack.push_back(SynthGrammar->MakeConstHole(Type));
     }
 
     void SynthLib2ESolver::VisitVariableGTerm(const VariableGTerm* TheTerm)
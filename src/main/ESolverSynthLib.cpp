@@ -66,6 +66,8 @@ namespace ESolverSynthLib {
              "SynthLib2 formatted input file")
             ("verbose,v", po::value<int32>(&Opts.StatsLevel)->default_value(DEFAULT_LOG_LEVEL),
              "Verbosity")
+            ("stats-file", po::value<string>(&Opts.StatsFileName)->default_value(""),
+             "Write the memory breakdown of the solver to this file, as JSON")
             ("memory-limit,m", po::value<uint64>(&Opts.MemoryLimit)->default_value(MEM_LIMIT_INFINITE),
              "Memory limit (bytes)")
             ("cpu-limit,t", po::value<uint64>(&Opts.CPULimit)->default_value(CPU_LIMIT_INFINITE),
@@ -74,7 +76,9 @@ namespace ESolverSynthLib {
              "Maximum cost of expansions to explore")
             ("random,r", po::value<uint32>(&Opts.RandomSeed)->implicit_value(DEFAULT_RANDOM_SEED),
              "Start the solver with a random seed to the SMT solver, a random seed will be used if none specified")
-            ("nodist,n", "Do not use distinguishability to prune search space");
+            ("nodist,n", "Do not use distinguishability to prune search space")
+            ("prune-solution,p", "Prune solution branches not taken on the counterexamples, "
+             "if an SMT check shows the result is equivalent");
         po::variables_map vm;
         po::store(po::command_line_parser(argc, argv).options(desc).positional(pdesc).run(), vm);
         po::notify(vm);
@@ -100,6 +104,7 @@ namespace ESolverSynthLib {
         } else {
             Opts.NoDist = false;
         }
+        Opts.PruneSolutions = (vm.count("prune-solution") > 0);
     }
 
 } /* End ESolverSynthLib namespace */
@@ -42,93 +42,95 @@
 
 namespace ESolver {
 
-    CrossProductGenerator::CrossProductGenerator(const vector<GenExpTLVec::ConstIterator>& Begins,
-                                                 const vector<GenExpTLVec::ConstIterator>& Ends,
-                                                 boost::pool<>* Pool)
-        : Begins(Begins), Ends(Ends), Currents(Begins), Done(false),
-          Size(Begins.size()), First(true), ElemSize(Begins.size()), Pool(Pool)
+    CrossProductGenerator::CrossProductGenerator()
+        : Bank(nullptr), Size(0), Done(true)
     {
-        // Check if any of the iterators are empty
-        for(uint32 i = 0; i < Size; ++i) {
-            if(Begins[i] == Ends[i]) {
-                CurrentElems = NULL;
-                Done = true;
-                return;
-            }
-        }
-        CurrentElems = (GenExpressionBase const**)Pool->malloc();
-        if(CurrentElems == NULL) {
-            throw OutOfMemoryException("Out of Memory!");
-        }
-        FixCurrentElems();
+        // Nothing here
     }
 
-    inline void CrossProductGenerator::FixCurrentElems()
+    CrossProductGenerator::~CrossProductGenerator()
     {
-        if(Done) {
-            return;
-        }
-        // Check if any iterator is empty
-        for(uint32 i = 0; i < Size; ++i) {
-            CurrentElems[i] = *(Currents[i]);
-        }
+        // Nothing here
     }
 
-    CrossProductGenerator::~CrossProductGenerator()
+    void CrossProductGenerator::Initialize(const ExpressionBank* Bank,
+                                           const vector<ExpBankEntry>& Args)
     {
-        if(CurrentElems != NULL) {
-            Pool->free(CurrentElems);
+        this->Bank = Bank;
+        Size = Args.size();
+        Done = false;
+        ArgSpans.resize(Size);
+        NumArgSpans.resize(Size);
+        CurrentSpans.assign(Size, 0);
+        CurrentIDs.resize(Size);
+        CurrentElems.resize(Size);
+        Tile.resize(ESOLVER_CROSS_PRODUCT_TILE_SIZE * Size);
+
+        // Check if any of the arguments are empty
+        for(uint32 i = 0; i < Size; ++i) {
+            if(Args[i].Size() == 0) {
+                Done = true;
+                return;
+            }
+            ArgSpans[i] = Bank->GetSpans(Args[i]);
+            NumArgSpans[i] = Args[i].NumSpans;
+            CurrentIDs[i] = ArgSpans[i][0].Begin;
+            CurrentElems[i] = Bank->Get(CurrentIDs[i]);
         }
     }
 
-    GenExpressionBase const** CrossProductGenerator::GetNext()
+    // Moves to the next tuple, false if there is none
+    inline bool CrossProductGenerator::Step()
     {
-        if(Done) {
-            return NULL;
-        }
-        if(First) {
-            First = false;
-            return CurrentElems;
-        }
-
-        bool Found = false;
         for(uint32 i = 0; i < Size; i++) {
-            if(++(Currents[i]) == Ends[i]) {
-                Currents[i] = Begins[i];
-            } else {
-                Found = true;
-                break;
+            if(++CurrentIDs[i] < ArgSpans[i][CurrentSpans[i]].End) {
+                CurrentElems[i] = Bank->Get(CurrentIDs[i]);
+                return true;
             }
+            if(++CurrentSpans[i] < NumArgSpans[i]) {
+                CurrentIDs[i] = ArgSpans[i][CurrentSpans[i]].Begin;
+                CurrentElems[i] = Bank->Get(CurrentIDs[i]);
+                return true;
+            }
+            CurrentSpans[i] = 0;
+            CurrentIDs[i] = ArgSpans[i][0].Begin;
+            CurrentElems[i] = Bank->Get(CurrentIDs[i]);
         }
-        
-        if(Found) {
-            FixCurrentElems();
-        } else {
-            Done = true;
-            Pool->free(CurrentElems);
-            CurrentElems = NULL;
-        }
-
-        return CurrentElems;
+        return false;
     }
 
-    void CrossProductGenerator::Reset()
+    uint32 CrossProductGenerator::GetNextTile()
     {
-        Done = false;
-        for(uint32 i = 0; i < Size; ++i) {
-            Currents[i] = Begins[i];
+        if(Done) {
+            return 0;
+        }
+        // The product of no arguments is a single empty tuple
+        if(Size == 0) {
+            Done = true;
+            return 1;
         }
-        First = true;
-    }
 
-    void CrossProductGenerator::RelinquishOwnerShip()
-    {
-        // We're supposed to assume that we've lost the
-        // CurrentElems we have allocated. Reallocate
-        CurrentElems = (GenExpressionBase const**)Pool->malloc();
-        if(CurrentElems == NULL) {
-            throw OutOfMemoryException("Out of Memory!");
+        uint32 NumTuples = 0;
+        while(NumTuples < ESOLVER_CROSS_PRODUCT_TILE_SIZE) {
+            // Copy a run of the first argument, with the others fixed
+            const uint32 SpanEnd = ArgSpans[0][CurrentSpans[0]].End;
+            const uint32 RunLength = min(SpanEnd - CurrentIDs[0],
+                                         (uint32)ESOLVER_CROSS_PRODUCT_TILE_SIZE - NumTuples);
+            for(uint32 j = 0; j < RunLength; ++j) {
+                auto Tuple = Tile.data() + (NumTuples + j) * Size;
+                Tuple[0] = Bank->Get(CurrentIDs[0] + j);
+                for(uint32 i = 1; i < Size; ++i) {
+                    Tuple[i] = CurrentElems[i];
+                }
+            }
+            NumTuples += RunLength;
+            CurrentIDs[0] += RunLength - 1;
+            if(!Step()) {
+                Done = true;
+                break;
+            }
         }
+        return NumTuples;
     }
 
 } /* End namespace */
@@ -42,35 +42,50 @@
 #define __ESOLVER_CROSS_PRODUCT_GENERATOR_HPP
 
 #include "../common/ESolverForwardDecls.hpp"
-#include "../containers/TwoLevelVec.hpp"
-#include <boost/pool/pool.hpp>
+#include "../containers/ExpressionBank.hpp"
+
+// The number of tuples in a tile
+#define ESOLVER_CROSS_PRODUCT_TILE_SIZE (64)
 
 namespace ESolver {
-    
+
+    // Generates the cross product of lists of spans of expression ids,
+    // a tile of tuples at a time. The tuples of a tile are stored one
+    // after the other in a buffer owned by the generator, which is
+    // overwritten by the next tile. The first argument varies fastest,
+    // so that most of a tile is a run of consecutive ids of the first
+    // argument. A generator can be reinitialized with new arguments,
+    // and reuses its buffers, so that iterating does not allocate
     class CrossProductGenerator
     {
     private:
-        vector<GenExpTLVec::ConstIterator> Begins;
-        vector<GenExpTLVec::ConstIterator> Ends;
-        vector<GenExpTLVec::ConstIterator> Currents;
-        GenExpressionBase const** CurrentElems;
+        // Each argument ranges over the ids of a list of spans
+        const ExpressionBank* Bank;
+        vector<const ExpIdSpan*> ArgSpans;
+        vector<uint32> NumArgSpans;
+        vector<uint32> CurrentSpans;
+        vector<uint32> CurrentIDs;
+        // The current tuple, the first argument is only
+        // filled in when the tuple is copied to a tile
+        vector<const GenExpressionBase*> CurrentElems;
+        vector<const GenExpressionBase*> Tile;
+        uint32 Size;
         bool Done;
-        const uint32 Size;
-        bool First;
-        const uint32 ElemSize;
-        boost::pool<>* Pool;
 
-        inline void FixCurrentElems();
-        
-    public:
-        CrossProductGenerator(const vector<GenExpTLVec::ConstIterator>& Begins,
-                              const vector<GenExpTLVec::ConstIterator>& Ends,
-                              boost::pool<>* Pool);
+        inline bool Step();
 
+    public:
+        CrossProductGenerator();
         ~CrossProductGenerator();
-        GenExpressionBase const** GetNext();
-        void Reset();
-        void RelinquishOwnerShip();
+
+        void Initialize(const ExpressionBank* Bank, const vector<ExpBankEntry>& Args);
+        // Returns the number of tuples in the next tile, zero at the end
+        uint32 GetNextTile();
+
+        inline GenExpressionBase const* const* GetTuple(uint32 Index) const
+        {
+            return Tile.data() + Index * Size;
+        }
     };
 }
 
@@ -90,6 +90,16 @@ namespace ESolver {
         // Nothing here
     }
 
+    const PartitionGenerator* PartitionGenerator::Get(uint32 N, uint32 K)
+    {
+        static unordered_map<uint64, const PartitionGenerator*> Generators;
+        auto& Retval = Generators[(((uint64)N) << 32) | K];
+        if (Retval == nullptr) {
+            Retval = new PartitionGenerator(N, K);
+        }
+        return Retval;
+    }
+
     const vector<uint32>& PartitionGenerator::Next()
     {
         if(Done) {
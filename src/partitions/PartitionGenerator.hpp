@@ -63,6 +63,10 @@ namespace ESolver {
     public:
         PartitionGenerator(uint32 N, uint32 K);
         virtual ~PartitionGenerator();
+        // Memoized generators, built once per (N, K) and shared by all
+        // callers. They are only meant to be indexed, which does not
+        // allocate, and live until the end of the run
+        static const PartitionGenerator* Get(uint32 N, uint32 K);
         const vector<uint32>& Next();
         void Reset();
         // Accessors
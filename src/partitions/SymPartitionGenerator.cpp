@@ -57,6 +57,16 @@ namespace ESolver {
         // Nothing here
     }
 
+    const SymPartitionGenerator* SymPartitionGenerator::Get(uint32 N)
+    {
+        static unordered_map<uint32, const SymPartitionGenerator*> Generators;
+        auto& Retval = Generators[N];
+        if (Retval == nullptr) {
+            Retval = new SymPartitionGenerator(N);
+        }
+        return Retval;
+    }
+
     void SymPartitionGenerator::Initialize()
     {
         // TODO:
@@ -54,6 +54,8 @@ namespace ESolver {
     public:
         SymPartitionGenerator(uint32 N);
         virtual ~SymPartitionGenerator();
+        // Memoized like PartitionGenerator::Get()
+        static const SymPartitionGenerator* Get(uint32 N);
     };
 
 } /* End namespace */
@@ -47,13 +47,16 @@
 #include "../z3interface/TheoremProver.hpp"
 #include "../descriptions/Grammar.hpp"
 #include "../descriptions/GrammarNodes.hpp"
+#include "../expressions/ExprManager.hpp"
 #include "../utils/TimeValue.hpp"
+#include "../utils/MemoryBreakdown.hpp"
 #include "../solverutils/EvalRule.hpp"
 #include "../visitors/ExpCheckers.hpp"
 #include "../visitors/SpecRewriter.hpp"
 #include "../visitors/Gatherers.hpp"
 #include "../visitors/PBEConsequentsInitializer.hpp"
 #include "../visitors/ExpressionSizeCounter.hpp"
+#include "../visitors/SolutionSimplifier.hpp"
 
 
 namespace ESolver {
@@ -61,6 +64,8 @@ namespace ESolver {
     CEGSolver::CEGSolver(const ESolverOpts* Opts)
             : ESolver(Opts), ConcEval(nullptr), ExpEnumerator(nullptr),
               TheMode(CEGSolverMode::CEG),
+              Separable(false), NumComponentsSolved(0),
+              ConstHoleArena(1 << 16),
               PBEPhase(PBESolvePhase::BuildTermExprs),
               DTBuilder(this)
     {
@@ -77,6 +82,18 @@ namespace ESolver {
         }
     }
 
+    // Collects the conjuncts of a (nested) conjunction
+    static inline void FlattenConjuncts(const Expression& Exp, vector<Expression>& Conjuncts)
+    {
+        if (Exp->GetOp()->GetName() == "and") {
+            for (auto const& Child : Exp->GetChildren()) {
+                FlattenConjuncts(Child, Conjuncts);
+            }
+        } else {
+            Conjuncts.push_back(Exp);
+        }
+    }
+
     inline bool CEGSolver::CheckSymbolicValidity(GenExpressionBase const* const* Exps)
     {
         vector<SMTExpr> Assumptions;
@@ -123,7 +140,8 @@ namespace ESolver {
 
     CallbackStatus CEGSolver::SubExpressionCallBack(const GenExpressionBase* Exp,
                                                     const ESFixedTypeBase* Type,
-                                                    uint32 ExpansionTypeID)
+                                                    uint32 ExpansionTypeID,
+                                                    uint32 EnumeratorIndex)
     {
         // Check if the subexpression is distinguishable
         uint32 StatusRet = 0;
@@ -135,9 +153,18 @@ namespace ESolver {
 
         CheckResourceLimits();
 
+        // Templates have no concrete signature, keep them all
+        if (ConstHoleOps.size() > 0 && Exp->HasConstHoles()) {
+            if (Opts.StatsLevel >= 4) {
+                TheLogger.Log4("Template.").Log4("\n");
+            }
+            return NONE_STATUS;
+        }
+
         auto Distinguishable =
                 ConcEval->CheckSubExpression(const_cast<GenExpressionBase*>(Exp),
-                                             Type, ExpansionTypeID, StatusRet);
+                                             Type, ExpansionTypeID, StatusRet,
+                                             EnumeratorIndex);
         if (Distinguishable) {
             ++NumDistExpressions;
             if (Opts.StatsLevel >= 4) {
@@ -171,6 +198,14 @@ namespace ESolver {
             }
         }
 
+        if (Separable) {
+            return ComponentExpressionCallBack(Exp, Type, ExpansionTypeID, EnumeratorIndex);
+        }
+
+        if (ConstHoleOps.size() > 0 && Exp->HasConstHoles()) {
+            return ConstHoleExpressionCallBack(Exp, Type, ExpansionTypeID);
+        }
+
         uint32 StatusRet = 0;
 
         NumExpressionsTried++;
@@ -235,6 +270,228 @@ namespace ESolver {
         }
     }
 
+    CallbackStatus CEGSolver::ComponentExpressionCallBack(const GenExpressionBase* Exp,
+                                                          const ESFixedTypeBase* Type,
+                                                          uint32 ExpansionTypeID,
+                                                          uint32 EnumeratorIndex)
+    {
+        uint32 StatusRet = 0;
+
+        NumExpressionsTried++;
+        CheckResourceLimits();
+
+        if (Opts.StatsLevel >= 4) {
+            TheLogger.Log4(EnumeratorIndex).Log4(". ").Log4(Exp->ToString()).Log4("... ");
+        }
+
+        auto ConcValid = ConcEval->CheckComponentValidity(Exp, Type, ExpansionTypeID,
+                                                          EnumeratorIndex, StatusRet);
+        if (!ConcValid && (StatusRet & CONCRETE_EVAL_DIST) == 0) {
+            if (Opts.StatsLevel >= 4) {
+                TheLogger.Log4("Invalid, Indist.").Log4("\n");
+            }
+            return DELETE_EXPRESSION;
+        } else if (!ConcValid) {
+            NumDistExpressions++;
+            if (Opts.StatsLevel >= 4) {
+                if ((StatusRet & CONCRETE_EVAL_PART) != 0) {
+                    TheLogger.Log4("Invalid, Dist (Partial).").Log4("\n");
+                } else {
+                    TheLogger.Log4("Invalid, Dist.").Log4("\n");
+                }
+            }
+            return NONE_STATUS;
+        }
+
+        NumDistExpressions++;
+        if (Opts.StatsLevel >= 4) {
+            TheLogger.Log4("Valid.").Log4("\n");
+        }
+
+        // This function is settled until the next restart.
+        // The expression stays alive in the enumerator's cache
+        ComponentSolutions[EnumeratorIndex] = Exp;
+        ++NumComponentsSolved;
+        if (NumComponentsSolved < SynthFuncs.size()) {
+            return STOP_ENUMERATION;
+        }
+
+        // Every function has a candidate, check the tuple
+        bool SymbValid = CheckSymbolicValidity(ComponentSolutions.data());
+        if (SymbValid) {
+            this->Complete = true;
+            Solutions.push_back(vector<pair<const SynthFuncOperator*,
+                                            Expression>>());
+            for (uint32 i = 0; i < SynthFuncs.size(); ++i) {
+                Solutions.back().push_back(pair<const SynthFuncOperator*,
+                                                Expression>(SynthFuncs[i],
+                                                            GenExpressionBase::ToUserExpression(
+                                                                    ComponentSolutions[i],
+                                                                    this)));
+            }
+            return STOP_ENUMERATION;
+        }
+
+        // The counterexample refutes at least one of the components.
+        // The candidates are owned by the enumerators, which are
+        // about to be reset, so we start over for all functions
+        SMTModel TheSMTModel;
+        SMTConcreteValueModel ConcSMTModel;
+        TP->GetConcreteModel(RelevantVars, TheSMTModel, ConcSMTModel, this);
+        ConcEval->AddPoint(ConcSMTModel);
+        ConcreteEvaluator::ResetSigStore(ConcEval);
+
+        ComponentSolutions.assign(SynthFuncs.size(), nullptr);
+        NumComponentsSolved = 0;
+        Restart = true;
+        return (CallbackStatus)(STOP_ENUMERATION | RESTART_ENUMERATION);
+    }
+
+    const GenExpressionBase* CEGSolver::NumberConstHoles(const GenExpressionBase* Exp)
+    {
+        if (!Exp->HasConstHoles()) {
+            return Exp;
+        }
+
+        auto Hole = Exp->As<GenConstHoleExpression>();
+        if (Hole != nullptr) {
+            // The variables are cached by position and type, so that
+            // templates of the same shape reuse them
+            const uint32 Index = CurHoleLeafOps.size();
+            auto Type = Hole->GetType();
+            auto It = ConstHoleLeafOps.find(make_pair(Index, Type));
+            const UQVarOperator* LeafOp;
+            if (It != ConstHoleLeafOps.end()) {
+                LeafOp = It->second;
+            } else {
+                LeafOp = CreateQuantifiedVariable("__ConstHoleLeaf_" +
+                                                  to_string(ConstHoleLeafOps.size()), Type);
+                ConstHoleLeafOps[make_pair(Index, Type)] = LeafOp;
+            }
+            // Positions below ConstHoleOps.size() belong to the
+            // grammar holes, which are never bound
+            LeafOp->SetPosition(ConstHoleOps.size() + Index);
+            CurHoleLeafOps.push_back(LeafOp);
+            CurHoleLeafNames.insert(LeafOp->GetName());
+            return new (ConstHoleArena.Allocate(sizeof(GenConstHoleExpression)))
+                GenConstHoleExpression(LeafOp);
+        }
+
+        auto Func = Exp->As<GenFuncExpression>();
+        if (Func != nullptr) {
+            const uint32 Arity = Func->GetOp()->GetArity();
+            vector<const GenExpressionBase*> Children(Arity);
+            for (uint32 i = 0; i < Arity; ++i) {
+                Children[i] = NumberConstHoles(Func->GetChildren()[i]);
+            }
+            return new (ConstHoleArena.Allocate(GenFuncExpression::GetSize(Arity)))
+                GenFuncExpression(Func->GetOp(), Children.data());
+        }
+
+        auto Let = Exp->As<GenLetExpression>();
+        if (Let != nullptr) {
+            const uint32 NumBindings = Let->GetNumBindings();
+            auto Bindings = (GenExpressionBase const**)
+                ConstHoleArena.Allocate(sizeof(GenExpressionBase const*) * NumBindings);
+            for (uint32 i = 0; i < NumBindings; ++i) {
+                auto Binding = Let->GetBindings()[i];
+                Bindings[i] = (Binding != nullptr ? NumberConstHoles(Binding) : nullptr);
+            }
+            auto LetBoundExp = NumberConstHoles(Let->GetLetBoundExp());
+            return new (ConstHoleArena.Allocate(sizeof(GenLetExpression)))
+                GenLetExpression(Bindings, LetBoundExp, NumBindings);
+        }
+
+        throw InternalError((string)"Internal Error: Unexpected expression with constant holes: " +
+                            Exp->ToString() + "\nAt: " + __FILE__ + ":" + to_string(__LINE__));
+    }
+
+    CallbackStatus CEGSolver::ConstHoleExpressionCallBack(const GenExpressionBase* Exp,
+                                                          const ESFixedTypeBase* Type,
+                                                          uint32 ExpansionTypeID)
+    {
+        NumExpressionsTried++;
+        CheckResourceLimits();
+
+        if (Opts.StatsLevel >= 4) {
+            TheLogger.Log4(Exp->ToString()).Log4("... ");
+        }
+
+        // The enumerator shares one leaf per grammar hole, give
+        // every occurrence in this template a value of its own
+        CurHoleLeafOps.clear();
+        CurHoleLeafNames.clear();
+        auto Template = NumberConstHoles(Exp);
+
+        bool AddedPoints = false;
+        for (uint32 Round = 0; Round < CEG_CONST_HOLE_MAX_ROUNDS; ++Round) {
+            // Find values for the holes that satisfy the spec on all points
+            auto Query = ConcEval->MakeConstHoleQuery(Template, TP);
+            auto TPRes = TP->CheckSatisfiability(Query);
+            if (TPRes == SOLVE_UNSATISFIABLE) {
+                break;
+            } else if (TPRes != SOLVE_SATISFIABLE) {
+                ConstHoleArena.Clear();
+                throw Z3Exception((string)"Error: Z3 returned an UNKNOWN result.\n" +
+                                  "Make sure all theories are decidable.");
+            }
+
+            SMTModel HoleSMTModel;
+            SMTConcreteValueModel HoleValues;
+            TP->GetConcreteModel(CurHoleLeafNames, HoleSMTModel, HoleValues, this);
+            for (auto const& LeafOp : CurHoleLeafOps) {
+                GenExpressionBase::BindConstHole(LeafOp, HoleValues[LeafOp->GetName()]);
+            }
+
+            if (Opts.StatsLevel >= 4) {
+                TheLogger.Log4("Instantiated to ").Log4(Template->ToString()).Log4("... ");
+            }
+
+            // The instantiated template is consistent with all the points
+            if (CheckSymbolicValidity(Template)) {
+                this->Complete = true;
+                Solutions.push_back(vector<pair<const SynthFuncOperator*,
+                                                Expression>>());
+                Solutions.back().push_back(pair<const SynthFuncOperator*,
+                                                Expression>(SynthFuncs[0],
+                                                            GenExpressionBase::ToUserExpression(
+                                                                    Template,
+                                                                    this)));
+                GenExpressionBase::ClearConstHoleBindings();
+                ConstHoleArena.Clear();
+                if (Opts.StatsLevel >= 4) {
+                    TheLogger.Log4("Valid.").Log4("\n");
+                }
+                return STOP_ENUMERATION;
+            }
+
+            // Refine the constants with the counterexample
+            SMTModel TheSMTModel;
+            SMTConcreteValueModel ConcSMTModel;
+            TP->GetConcreteModel(RelevantVars, TheSMTModel, ConcSMTModel, this);
+            GenExpressionBase::ClearConstHoleBindings();
+            ConcEval->AddPoint(ConcSMTModel);
+            AddedPoints = true;
+        }
+
+        GenExpressionBase::ClearConstHoleBindings();
+        ConstHoleArena.Clear();
+        if (Opts.StatsLevel >= 4) {
+            TheLogger.Log4("No constants.").Log4("\n");
+        }
+        if (!AddedPoints) {
+            return NONE_STATUS;
+        }
+
+        // The signatures computed so far are over fewer points
+        ConcreteEvaluator::ResetSigStore(ConcEval);
+        if (!Opts.NoDist) {
+            Restart = true;
+            return STOP_ENUMERATION;
+        }
+        return NONE_STATUS;
+    }
+
     CallbackStatus CEGSolver::PBEEnumDecisionTree(const GenExpressionBase* Exp,
                                                   const ESFixedTypeBase* Type,
                                                   uint32 ExpansionTypeID)
@@ -480,8 +737,8 @@ namespace ESolver {
                                                  ESFixedTypeBase const* const* Types,
                                                  uint32 const* ExpansionTypeIDs)
     {
+        uint32 StatusRet = 0;
         NumExpressionsTried++;
-        NumDistExpressions++;
         CheckResourceLimits();
 
         if (Opts.StatsLevel >= 4) {
@@ -494,8 +751,14 @@ namespace ESolver {
             TheLogger.Log4("\n");
         }
 
+        // Each component has already been found distinguishable
+        // by the enumerator, so the tuple is distinguishable as well,
+        // unless some component could not be evaluated completely
         auto ConcValid =
-                ConcEval->CheckConcreteValidity(Exps, Types, ExpansionTypeIDs);
+                ConcEval->CheckConcreteValidity(Exps, Types, ExpansionTypeIDs, StatusRet);
+        if ((StatusRet & CONCRETE_EVAL_DIST) != 0) {
+            NumDistExpressions++;
+        }
         if (!ConcValid) {
             return NONE_STATUS;
         }
@@ -518,10 +781,108 @@ namespace ESolver {
             TP->GetConcreteModel(RelevantVars, TheSMTModel, ConcSMTModel, this);
             ConcEval->AddPoint(ConcSMTModel);
             ConcreteEvaluator::ResetSigStore(ConcEval);
-            return NONE_STATUS;
+
+            // The components cached by the enumerators were pruned
+            // w.r.t. the old points, so we need to start over
+            if (!Opts.NoDist) {
+                Restart = true;
+                return STOP_ENUMERATION;
+            } else {
+                return NONE_STATUS;
+            }
         }
     }
 
+    // A spec is separable when every conjunct of the rewritten
+    // constraint, along with the eval rules it depends on, refers to
+    // at most one synth func. Conjuncts which refer to no synth func
+    // are added to every component.
+    bool CEGSolver::BuildComponentSpecs(vector<Expression>& ComponentSpecs)
+    {
+        const uint32 NumSynthFuncs = SynthFuncs.size();
+        if (NumSynthFuncs < 2 || RewrittenConstraint->GetOp()->GetName() != "=>") {
+            return false;
+        }
+
+        auto const& Children = RewrittenConstraint->GetChildren();
+        vector<Expression> Antecedents;
+        vector<Expression> Conjuncts;
+        FlattenConjuncts(Children[0], Antecedents);
+        FlattenConjuncts(Children[1], Conjuncts);
+
+        // The synth funcs that each derived aux var depends on
+        unordered_map<const AuxVarOperator*, set<uint32>> AuxVarDeps;
+        auto GatherDeps = [&] (const Expression& Exp) -> set<uint32>
+        {
+            set<uint32> Retval;
+            for (auto const& SynthFunc : SynthFuncGatherer::Do(Exp)) {
+                Retval.insert(SynthFunc->GetPosition());
+            }
+            for (auto const& AuxVar : AuxVarGatherer::Do(Exp)) {
+                auto it = AuxVarDeps.find(AuxVar);
+                if (it != AuxVarDeps.end()) {
+                    Retval.insert(it->second.begin(), it->second.end());
+                }
+            }
+            return Retval;
+        };
+
+        vector<vector<Expression>> ComponentAntecedents(NumSynthFuncs);
+        vector<vector<Expression>> ComponentConjuncts(NumSynthFuncs);
+
+        auto Distribute = [&] (const Expression& Exp, const set<uint32>& Deps,
+                               vector<vector<Expression>>& Components) -> bool
+        {
+            if (Deps.size() > 1) {
+                return false;
+            }
+            if (Deps.size() == 0) {
+                for (auto& Component : Components) {
+                    Component.push_back(Exp);
+                }
+            } else {
+                Components[*Deps.begin()].push_back(Exp);
+            }
+            return true;
+        };
+
+        // The eval rules appear in the order in which they were
+        // created, i.e., an argument's rule before the application's
+        for (auto const& Antecedent : Antecedents) {
+            set<uint32> Deps;
+            auto LHS = (Antecedent->GetChildren().size() == 2 ?
+                        UserExpressionBase::As<UserAuxVarExpression>(Antecedent->GetChildren()[1]) :
+                        nullptr);
+            if (Antecedent->GetOp()->GetName() == "=" && LHS != nullptr) {
+                Deps = GatherDeps(Antecedent->GetChildren()[0]);
+                AuxVarDeps[LHS->GetOp()] = Deps;
+            } else {
+                Deps = GatherDeps(Antecedent);
+            }
+            if (!Distribute(Antecedent, Deps, ComponentAntecedents)) {
+                return false;
+            }
+        }
+
+        for (auto const& Conjunct : Conjuncts) {
+            if (!Distribute(Conjunct, GatherDeps(Conjunct), ComponentConjuncts)) {
+                return false;
+            }
+        }
+
+        ComponentSpecs.clear();
+        for (uint32 i = 0; i < NumSynthFuncs; ++i) {
+            auto Antecedent = (ComponentAntecedents[i].size() == 0 ?
+                               CreateTrueExpression() :
+                               CreateAndExpression(ComponentAntecedents[i]));
+            auto Consequent = (ComponentConjuncts[i].size() == 0 ?
+                               CreateTrueExpression() :
+                               CreateAndExpression(ComponentConjuncts[i]));
+            ComponentSpecs.push_back(CreateExpression("=>", Antecedent, Consequent));
+        }
+        return true;
+    }
+
     SolutionMap CEGSolver::Solve(const Expression& Constraint)
     {
         NumExpressionsTried = NumDistExpressions = (uint64) 0;
@@ -584,11 +945,39 @@ namespace ESolver {
             SynthFuncTypes[i] = SynthFuncs[i]->GetEvalType();
         }
 
+        // Number the constant holes across all the grammars
+        ConstHoleOps.clear();
+        for (auto const& CurGrammar : SynthGrammars) {
+            for (auto const& Hole : CurGrammar->GetConstHoles()) {
+                Hole->GetOp()->SetPosition(ConstHoleOps.size());
+                ConstHoleOps.push_back(Hole->GetOp());
+            }
+        }
+
+        // Bail out before any enumerator or evaluator is set up
+        const bool IsPBE = (ConstRelevantVars.size() == RelevantVars.size() &&
+                            ConstRelevantVars.size() == PBEAntecedentExprs.size());
+        if (ConstHoleOps.size() > 0 && (IsPBE || NumSynthFuncs > 1)) {
+            throw UnimplementedException((string)"(Constant <Type>) constructs are only supported " +
+                                         "when synthesizing a single function from a " +
+                                         "non-PBE specification");
+        }
+
+        // Check if the functions can be synthesized independently
+        vector<Expression> ComponentSpecs;
+        Separable = BuildComponentSpecs(ComponentSpecs);
+        ComponentSolutions.assign(NumSynthFuncs, nullptr);
+        NumComponentsSolved = 0;
+        if (Separable && Opts.StatsLevel >= 2) {
+            TheLogger.Log2("Constraint is separable, synthesizing ").Log2(NumSynthFuncs).Log2(
+                    " functions independently").Log2("\n");
+        }
+
         // Create the enumerator
         if (NumSynthFuncs == 1) {
             ExpEnumerator = new CFGEnumeratorSingle(this, SynthGrammars[0]);
         } else {
-            ExpEnumerator = new CFGEnumeratorMulti(this, SynthGrammars);
+            ExpEnumerator = new CFGEnumeratorMulti(this, SynthGrammars, Separable);
         }
 
         vector<Expression> PBEConstraints;
@@ -597,8 +986,7 @@ namespace ESolver {
         vector<map<vector<uint32>, uint32>> PBESynthFunAppMap;
 
         // Check PBE mode and, if so, switch mode and do initialization
-        if (ConstRelevantVars.size() == RelevantVars.size() &&
-                ConstRelevantVars.size() == PBEAntecedentExprs.size()) {
+        if (IsPBE) {
             TheMode = CEGSolverMode::PBE;
             if (Opts.StatsLevel > 2) {
                 TheLogger.Log1("\n").Log1(
@@ -625,16 +1013,21 @@ namespace ESolver {
                                              SynthFunAppMaps,
                                              SynthFuncTypes,
                                              TheLogger);
+            if (Separable) {
+                ConcEval->SetComponentSpecs(ComponentSpecs);
+            }
         }
 
         // Set up evaluation buffers/stacks for generated expressions
         GenExpressionBase::Initialize();
 
+        // When separable, the cost is that of each function on its own
+        const uint32 MinCost = (Separable ? 1 : NumSynthFuncs);
         uint32 NumRestarts = 0;
         PreSolve();
         do {
             Restart = false;
-            for (uint32 i = NumSynthFuncs; i <= Opts.CostBudget && !Complete;
+            for (uint32 i = MinCost; i <= Opts.CostBudget && !Complete;
                  ++i) {
                 if (Opts.StatsLevel >= 2) {
                     TheLogger.Log1("Trying expressions of size ").Log1(i).Log1(
@@ -643,6 +1036,13 @@ namespace ESolver {
                 ExpEnumerator->EnumerateOfCost(i);
                 if (Restart) {
                     ExpEnumerator->Reset();
+                    // The user expressions built for the candidates
+                    // of this round are no longer referenced, nor are
+                    // the strings and wide bitvectors their evaluation
+                    // computed
+                    ExpMgr->GC();
+                    CollectStrings();
+                    CollectWideBitVectors();
                     ++NumRestarts;
                     break;
                 }
@@ -655,6 +1055,24 @@ namespace ESolver {
         // We're done
         PostSolve();
 
+        // Simplify the solutions before handing them out
+        for (auto& Solution : Solutions) {
+            for (auto& FuncExp : Solution) {
+                const uint32 FuncIndex = FuncExp.first->GetPosition();
+                vector<vector<const ConcreteValueBase*>> Valuations;
+                if (Opts.PruneSolutions) {
+                    if (ConcEval != nullptr) {
+                        ConcEval->GetParamValuations(FuncIndex, Valuations);
+                    }
+                    for (auto const& EvalPtr : PBEEvalPtrs) {
+                        EvalPtr->GetParamValuations(FuncIndex, Valuations);
+                    }
+                }
+                FuncExp.second = SolutionSimplifier::Do(this, FuncExp.second, Valuations,
+                                                        (Opts.PruneSolutions ? TP : nullptr));
+            }
+        }
+
         if (Opts.StatsLevel >= 1) {
             TheLogger.Log1("Tried ").Log1(NumExpressionsTried).Log1(
                     " expressions in all.\n");
@@ -670,6 +1088,8 @@ namespace ESolver {
             }
         }
 
+        ReportMemoryBreakdown();
+
         EndSolve();
         return Solutions;
     }
@@ -727,6 +1147,15 @@ namespace ESolver {
         ConcreteEvaluator::ResetSigStore(PBEEvalPtrs.front().get());
     }
 
+    void CEGSolver::GetMemoryBreakdown(MemoryBreakdown& Breakdown) const
+    {
+        ESolver::GetMemoryBreakdown(Breakdown);
+        if (ExpEnumerator != nullptr) {
+            ExpEnumerator->GetMemoryBreakdown(Breakdown);
+        }
+        ConcreteEvaluator::GetMemoryBreakdown(Breakdown);
+    }
+
     void CEGSolver::EndSolve()
     {
         GenExpressionBase::Finalize();
@@ -48,6 +48,11 @@
 #include "../z3interface/Z3Objects.hpp"
 #include "../utils/Hashers.hpp"
 #include "../solverutils/DecisionTreeExprBuilder.hpp"
+#include "../containers/BumpArena.hpp"
+
+// Number of counterexamples gathered for a single template with
+// constant holes before moving on to the next template
+#define CEG_CONST_HOLE_MAX_ROUNDS ((uint32)8)
 
 namespace ESolver {
 
@@ -79,6 +84,24 @@ namespace ESolver {
         uint64 NumDistExpressions;
         CEGSolverMode TheMode;
 
+        // Divide and conquer for separable multi function specs:
+        // each synth func is enumerated and checked against only the
+        // conjuncts it appears in, the candidates for each function
+        // are combined into a tuple once every function has one.
+        bool Separable;
+        vector<const GenExpressionBase*> ComponentSolutions;
+        uint32 NumComponentsSolved;
+
+        // Constant holes in the grammar. Expressions containing holes
+        // are templates. When a template is complete, each hole leaf in
+        // it gets a variable of its own, numbered by its position in the
+        // template, and the values are solved for over the current points
+        vector<const UQVarOperator*> ConstHoleOps;
+        map<pair<uint32, const ESFixedTypeBase*>, const UQVarOperator*> ConstHoleLeafOps;
+        vector<const UQVarOperator*> CurHoleLeafOps;
+        set<string> CurHoleLeafNames;
+        BumpArena ConstHoleArena;
+
         // Enumeration phases in PBE
         enum class PBESolvePhase
         {
@@ -109,6 +132,19 @@ namespace ESolver {
         // Multifunction case
         inline bool CheckSymbolicValidity(GenExpressionBase const* const* Exps);
 
+        bool BuildComponentSpecs(vector<Expression>& ComponentSpecs);
+
+        CallbackStatus ComponentExpressionCallBack(const GenExpressionBase* Exp,
+                                                   const ESFixedTypeBase* Type,
+                                                   uint32 ExpansionTypeID,
+                                                   uint32 EnumeratorIndex);
+
+        CallbackStatus ConstHoleExpressionCallBack(const GenExpressionBase* Exp,
+                                                   const ESFixedTypeBase* Type,
+                                                   uint32 ExpansionTypeID);
+        // Copies the template with every hole leaf bound to its own variable
+        const GenExpressionBase* NumberConstHoles(const GenExpressionBase* Exp);
+
         template<class T>
         inline void swap(T& x, T& y)
         {
@@ -138,7 +174,8 @@ namespace ESolver {
 
         virtual CallbackStatus SubExpressionCallBack(const GenExpressionBase* Exp,
                                                      const ESFixedTypeBase* Type,
-                                                     uint32 ExpansionTypeID) override;
+                                                     uint32 ExpansionTypeID,
+                                                     uint32 EnumeratorIndex = 0) override;
 
         virtual CallbackStatus ExpressionCallBack(const GenExpressionBase* Exp,
                                                   const ESFixedTypeBase* Type,
@@ -153,6 +190,7 @@ namespace ESolver {
         virtual SolutionMap Solve(const Expression& Constraint) override;
 
         virtual void EndSolve() override;
+        virtual void GetMemoryBreakdown(MemoryBreakdown& Breakdown) const override;
     };
 
 } /* End namespace */
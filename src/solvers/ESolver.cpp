@@ -43,10 +43,13 @@
 #include "../z3interface/Z3TheoremProver.hpp"
 #include "../scoping/ScopeManager.hpp"
 #include "../values/ValueManager.hpp"
+#include "../values/WideBitVector.hpp"
+#include "../values/StringStore.hpp"
 #include "../expressions/ExprManager.hpp"
 #include "../solverutils/ConstManager.hpp"
 #include "../solverutils/TypeManager.hpp"
 #include "../utils/TextUtils.hpp"
+#include "../utils/MemoryBreakdown.hpp"
 #include "../visitors/ExpCheckers.hpp"
 #include "../logics/BVLogic.hpp"
 #include "../logics/LIALogic.hpp"
@@ -99,6 +102,8 @@ namespace ESolver {
 
         ScopeMgr = new ScopeManager();
         ValMgr = new ValueManager();
+        StrStore = new StringStore();
+        WideBVs = new WideBVStore();
         ExpMgr = new ExprManager();
         ConstMgr = new ConstManager();
         TypeMgr = new TypeManager(TP);
@@ -120,6 +125,8 @@ namespace ESolver {
 
         delete ScopeMgr;
         delete ValMgr;
+        delete StrStore;
+        delete WideBVs;
         delete ExpMgr;
         delete ConstMgr;
         delete TypeMgr;
@@ -250,14 +257,29 @@ namespace ESolver {
         string TypeName = ESOLVER_BITVEC_PREFIX + "_" + to_string(NumBits);
         auto Retval = TypeMgr->LookupType<ESBVType>(TypeName);
         if (Retval == nullptr) {
-            Retval = TypeMgr->CreateType<ESBVType>(NumBits);
+            Retval = TypeMgr->CreateType<ESBVType>(NumBits, WideBVs);
             TypeMgr->BindType(TypeName, Retval);
             RegisterType(Retval);
+            if (WideBV::IsWide(NumBits)) {
+                WideBVTypes.push_back(Retval);
+            }
         }
         
         return Retval;
     }
 
+    const ESFixedTypeBase* ESolver::CreateStringType()
+    {
+        auto Retval = TypeMgr->LookupType<ESStringType>("String");
+        if (Retval == nullptr) {
+            Retval = TypeMgr->CreateType<ESStringType>(StrStore);
+            TypeMgr->BindType("String", Retval);
+            RegisterType(Retval);
+        }
+
+        return Retval;
+    }
+
     void ESolver::BindType(const string& TypeName, const ESFixedTypeBase* Type)
     {
         if (LookupType(TypeName) != nullptr) {
@@ -278,9 +300,15 @@ namespace ESolver {
         case BaseTypeEnum:
             return CreateValue(Type, ParseEnumString(ValueString, Type));
         case BaseTypeBitVector:
+            if (WideBV::IsWide(Type->As<ESBVType>()->GetSize())) {
+                auto Limbs = WideBV::Parse(ValueString, Type->As<ESBVType>()->GetSize());
+                return CreateValue(Type, WideBVs->Intern(Limbs));
+            }
             // Maintain bit representation using type punning
             TempValue = ParseBVString(ValueString, Type->As<ESBVType>()->GetSize());
             return CreateValue(Type, *(int64*)&TempValue);
+        case BaseTypeString:
+            return CreateValue(Type, StrStore->ParseLiteral(ValueString));
         default:
             throw TypeException("Unhandled type in CreateValue()");
         }
@@ -344,7 +372,8 @@ namespace ESolver {
                                                            ConcFunctorBase* ConcFunctor,
                                                            bool Symmetric,
                                                            bool Builtin,
-                                                           uint32 Cost)
+                                                           uint32 Cost,
+                                                           const RewriteFacts* Facts)
     {
         CheckOperatorRedeclaration(FuncName, DomainTypes);
         if (!Builtin) {
@@ -355,7 +384,8 @@ namespace ESolver {
             }
         }
         auto FuncType = TypeMgr->CreateType<ESFunctionType>(DomainTypes, RangeType);
-        auto Op = new InterpretedFuncOperator(FuncName, FuncType, ConcFunctor, SymbFunctor, Symmetric, Cost);
+        auto Op = new InterpretedFuncOperator(FuncName, FuncType, ConcFunctor, SymbFunctor, Symmetric, Cost,
+                                              (Facts != nullptr ? *Facts : RewriteFacts()));
         ScopeMgr->AddOperator(Op, Builtin);
         return Op;
     }
@@ -561,7 +591,6 @@ namespace ESolver {
                                          const vector<Expression>& Children)
     {
         Expression NewExp = CreateRawExpression(OpInfo, Children);
-        ExpMgr->GC();
         return ExpMgr->GetExp(NewExp);
     }
 
@@ -763,15 +792,25 @@ namespace ESolver {
 
     void ESolver::CheckResourceLimits()
     {
-        if(ResourceLimitManager::CheckTimeOut()) {
-            EndSolve();
-            SolveEndTime = TimeValue::GetTimeValue();
-            SolveEndMemStats = MemStats::GetMemStats();
+        const bool TimedOut = ResourceLimitManager::CheckTimeOut();
+        if (!TimedOut && !ResourceLimitManager::CheckMemOut()) {
+            return;
+        }
+
+        // The breakdown is reported before EndSolve() frees the
+        // structures it covers, it matters most when we run out.
+        // Failing to write it must not hide the limit being hit
+        try {
+            ReportMemoryBreakdown();
+        } catch (const OptionException& Ex) {
+            TheLogger.Log0("Warning: ").Log0(Ex.what()).Log0("\n");
+        }
+        EndSolve();
+        SolveEndTime = TimeValue::GetTimeValue();
+        SolveEndMemStats = MemStats::GetMemStats();
+        if (TimedOut) {
             throw OutOfTimeException("Query time limit exceeded");
-        } else if(ResourceLimitManager::CheckMemOut()) {
-            EndSolve();
-            SolveEndTime = TimeValue::GetTimeValue();
-            SolveEndMemStats = MemStats::GetMemStats();
+        } else {
             throw OutOfMemoryException("Out of memory");
         }
     }
@@ -801,6 +840,58 @@ namespace ESolver {
         // TheLogger.Log1(SolveEndMemStats - SolveStartMemStats).Log1("\n\n");
     }
 
+    void ESolver::CollectStrings()
+    {
+        auto StringType = TypeMgr->LookupType<ESStringType>("String");
+        if (StringType == nullptr) {
+            return;
+        }
+        vector<int64> Handles;
+        ValMgr->GetValuesOfType(StringType, Handles);
+        StrStore->Retain(Handles);
+    }
+
+    void ESolver::CollectWideBitVectors()
+    {
+        vector<int64> Handles;
+        for (auto const& Type : WideBVTypes) {
+            ValMgr->GetValuesOfType(Type, Handles);
+        }
+        WideBVs->Retain(Handles);
+    }
+
+    void ESolver::GetMemoryBreakdown(MemoryBreakdown& Breakdown) const
+    {
+        ValMgr->GetMemoryBreakdown(Breakdown);
+        StrStore->GetMemoryBreakdown(Breakdown);
+        WideBVs->GetMemoryBreakdown(Breakdown);
+        Breakdown.Add("ExprManager.NumExps", ExpMgr->GetNumExps());
+        Breakdown.Add("TheoremProver.AllocBytes", TP->GetEstimatedAllocSize());
+    }
+
+    void ESolver::ReportMemoryBreakdown()
+    {
+        if (Opts.StatsLevel < 1 && Opts.StatsFileName == "") {
+            return;
+        }
+        MemoryBreakdown Breakdown;
+        GetMemoryBreakdown(Breakdown);
+        if (Opts.StatsLevel >= 1) {
+            TheLogger.Log1("Memory Breakdown:\n");
+            for (auto const& Counter : Breakdown.GetCounters()) {
+                TheLogger.Log1("    ").Log1(Counter.first).Log1(": ")
+                    .Log1(Counter.second).Log1("\n");
+            }
+        }
+        if (Opts.StatsFileName != "") {
+            ofstream StatsFile(Opts.StatsFileName);
+            if (!StatsFile.good()) {
+                throw OptionException((string)"Could not open stats file: " + Opts.StatsFileName);
+            }
+            StatsFile << Breakdown.ToJSON();
+        }
+    }
+
     const ESolverOpts& ESolver::GetOpts() const
     {
         return Opts;
@@ -84,6 +84,10 @@ namespace ESolver {
 
         // Managers
         ValueManager* ValMgr;
+        StringStore* StrStore;
+        WideBVStore* WideBVs;
+        // The bitvector types whose values are handles into WideBVs
+        vector<const ESBVType*> WideBVTypes;
         ScopeManager* ScopeMgr;
         ExprManager* ExpMgr;
         std::vector<Expression> UnmanagedExps;
@@ -135,6 +139,7 @@ namespace ESolver {
                                          const vector<string>& EnumConstructors);
 
         const ESFixedTypeBase* CreateBitVectorType(uint32 NumBits);
+        const ESFixedTypeBase* CreateStringType();
 
         // Value creation methods
         const ConcreteValueBase* CreateValue(const ESFixedTypeBase* Type, const string& ValueString);
@@ -154,7 +159,8 @@ namespace ESolver {
         // Anonymous constants
         const ConstOperator* CreateConstant(const ConcreteValueBase* ConstantValue);
 
-        // An interpreted function
+        // An interpreted function, Facts are the algebraic
+        // identities the enumerators may prune with, if any
         const InterpretedFuncOperator* CreateFunction(const string& FuncName,
                                                       const vector<const ESFixedTypeBase*>& DomainTypes,
                                                       const ESFixedTypeBase* RangeType,
@@ -162,7 +168,8 @@ namespace ESolver {
                                                       ConcFunctorBase* ConcFunctor,
                                                       bool Symmetric = false,
                                                       bool Builtin = false,
-                                                      uint32 Cost = 1);
+                                                      uint32 Cost = 1,
+                                                      const RewriteFacts* Facts = nullptr);
 
         // A macro
         const MacroOperator* CreateFunction(const string& FuncName,
@@ -265,7 +272,8 @@ namespace ESolver {
         // towards to goal of enumerating the top level expression
         virtual CallbackStatus SubExpressionCallBack(const GenExpressionBase* Exp,
                                                      const ESFixedTypeBase* Type,
-                                                     uint32 ExpansionTypeID) = 0;
+                                                     uint32 ExpansionTypeID,
+                                                     uint32 EnumeratorIndex = 0) = 0;
 
         // Callback for each enumerated expression.
         // special case for single function synthesis
@@ -291,9 +299,23 @@ namespace ESolver {
         void PreSolve();
         // Clients should call this after a Solve
         void PostSolve();
+        // Drops the strings that no value refers to, i.e., those
+        // computed while enumerating. Clients call this when they
+        // restart the enumeration, once nothing else refers to them
+        void CollectStrings();
+        // Likewise for the values of bitvectors wider than 64 bits
+        void CollectWideBitVectors();
 
         // To be implemented by clients for abrupt end of solve
         virtual void EndSolve() = 0;
+
+        // Sizes of the managers and the SMT solver, subclasses
+        // add those of their enumerators and evaluators
+        virtual void GetMemoryBreakdown(MemoryBreakdown& Breakdown) const;
+        // Logs the breakdown and writes it to the stats file, as
+        // the options ask. Called at the end of a solve, and when
+        // a resource limit is hit
+        void ReportMemoryBreakdown();
     };
 
 } /* End namespace */
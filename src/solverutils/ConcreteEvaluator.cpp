@@ -41,12 +41,16 @@
 #include "ConcreteEvaluator.hpp"
 #include "../descriptions/Operators.hpp"
 #include "../exceptions/ESException.hpp"
-#include "../values/Signature.hpp"
+#include "../values/SignatureStore.hpp"
 #include "../solvers/ESolver.hpp"
 #include "../values/ConcreteValueBase.hpp"
 #include "../solverutils/EvalRule.hpp"
 #include "../expressions/GenExpression.hpp"
 #include "../solvers/CEGSolver.hpp"
+#include "../z3interface/TheoremProver.hpp"
+#include "../descriptions/ESType.hpp"
+#include "../descriptions/FunctorBase.hpp"
+#include "../utils/MemoryBreakdown.hpp"
 
 namespace ESolver {
 
@@ -55,6 +59,8 @@ namespace ESolver {
     // Flag indicating that an expression is partial
     // and could not be evaluated
     bool PartialExpression = false;
+    // Flag indicating that integer arithmetic overflowed
+    bool ConcreteOverflow = false;
 
     // vars related to signatures are shared among evaluators
     uint32 ConcreteEvaluator::SigStoreMasterEvalId = 0;
@@ -62,13 +68,11 @@ namespace ESolver {
     uint32 ConcreteEvaluator::NumPoints = 0;
     vector<vector<const ConcreteValueBase*>> ConcreteEvaluator::Points;
     vector<vector<const ConcreteValueBase*>> ConcreteEvaluator::SubExpEvalPoints;
+    vector<uint8> ConcreteEvaluator::OverflowedPoints;
 
-    SigSetType ConcreteEvaluator::SigSet;
-
-    // Pool for the signature objects
-    boost::pool<>* ConcreteEvaluator::SigPool = nullptr;
-
-    boost::pool<>* ConcreteEvaluator::SigVecPool = nullptr;
+    SignatureStore ConcreteEvaluator::SigStore;
+    SignatureStore ConcreteEvaluator::PackedSigStore;
+    unordered_map<const GenExpressionBase*, uint32> ConcreteEvaluator::PackedSigs;
 
     ConcreteEvaluator::ConcreteEvaluator(ESolver* Solver, const Expression& RewrittenSpec,
                                          uint32 NumSynthFuncs,
@@ -83,17 +87,142 @@ namespace ESolver {
           BaseAuxVars(BaseAuxVars), DerivedAuxVars(DerivedAuxVars),
           SynthFunAppMaps(SynthFunAppMaps.size()),
           SynthFuncTypes(SynthFuncTypes),
+          SynthFunAppOffsets(SynthFunAppMaps.size(), 0),
+          ComponentExps(NumSynthFuncs, nullptr),
           NumBaseAuxVars(BaseAuxVars.size()), NumDerivedAuxVars(DerivedAuxVars.size()),
           NumTotalAuxVars(BaseAuxVars.size() + DerivedAuxVars.size()),
           NumSynthFuncs(NumSynthFuncs),
-          NoDist(Solver->GetOpts().NoDist), TheLogger(TheLogger), TheId(EvalId)
+          NoDist(Solver->GetOpts().NoDist), TheLogger(TheLogger), TheId(EvalId),
+          NumChecksSinceReorder(0)
     {
+        uint32 Offset = 0;
         for (uint32 i = 0, last = SynthFunAppMaps.size(); i < last; ++i) {
             this->SynthFunAppMaps[i] =
                 vector<pair<vector<uint32>, uint32>>(SynthFunAppMaps[i].begin(),
                                                      SynthFunAppMaps[i].end());
             NumSynthFunApps += SynthFunAppMaps[i].size();
+            SynthFunAppOffsets[i] = Offset;
+            Offset += SynthFunAppMaps[i].size();
+        }
+    }
+
+    inline void ConcreteEvaluator::AddToPointOrder(uint32 PointIdx)
+    {
+        // A new point is a counterexample to the last candidate that
+        // was tried, and is likely to reject the next few as well.
+        // Put it first, as if it were as good as the current leader
+        uint64 MaxRejections = 0;
+        for (auto const& Count : PointRejections) {
+            MaxRejections = max(MaxRejections, Count);
+        }
+        PointRejections.push_back(MaxRejections);
+        PointOrder.insert(PointOrder.begin(), PointIdx);
+    }
+
+    inline void ConcreteEvaluator::RecordRejection(uint32 PointIdx)
+    {
+        ++PointRejections[PointIdx];
+    }
+
+    inline void ConcreteEvaluator::ReorderPoints()
+    {
+        if (++NumChecksSinceReorder < CONCRETE_EVAL_REORDER_INTERVAL) {
+            return;
+        }
+        NumChecksSinceReorder = 0;
+        stable_sort(PointOrder.begin(), PointOrder.end(),
+                    [&] (uint32 Point1, uint32 Point2) -> bool
+                    {
+                        return PointRejections[Point1] > PointRejections[Point2];
+                    });
+        // Age the statistics, so that the order can adapt
+        // as the candidates grow in size
+        for (auto& Count : PointRejections) {
+            Count >>= 1;
+        }
+    }
+
+    inline bool ConcreteEvaluator::EvaluatePacked(const GenExpressionBase* Exp,
+                                                  uint64* Words, uint32 Size)
+    {
+        auto FuncExp = Exp->As<GenFuncExpression>();
+        if (FuncExp == nullptr) {
+            return false;
+        }
+        const uint32 Arity = FuncExp->GetOp()->GetArity();
+        if (Arity > 3) {
+            return false;
+        }
+        const uint64* ArgWords[3];
+        auto const Children = FuncExp->GetChildren();
+        for (uint32 i = 0; i < Arity; ++i) {
+            auto it = PackedSigs.find(Children[i]);
+            if (it == PackedSigs.end()) {
+                return false;
+            }
+            ArgWords[i] = (const uint64*)PackedSigStore.GetRow(it->second);
+        }
+
+        const uint32 NumWords = SignatureStore::GetNumPackedWords(Size);
+        if (!FuncExp->GetOp()->GetConcFunctor()->EvaluatePacked(ArgWords, NumWords, Words)) {
+            return false;
+        }
+        if (Size % 64 != 0) {
+            Words[NumWords - 1] &= ((uint64)1 << (Size % 64)) - 1;
+        }
+        return true;
+    }
+
+    inline bool ConcreteEvaluator::EvaluateAppsAtPoint(GenExpressionBase const* const* Exps,
+                                                       uint32 PointIdx, uint32& Status)
+    {
+        auto const& CurPoint = Points[PointIdx];
+        uint32 j = 0;
+        for (uint32 SynthFunIndex = 0; SynthFunIndex < NumSynthFuncs; ++SynthFunIndex) {
+            for (auto const& AppMapTargetPos : SynthFunAppMaps[SynthFunIndex]) {
+                auto const& AppMap = AppMapTargetPos.first;
+                GenExpressionBase::Evaluate(const_cast<GenExpressionBase*>(Exps[SynthFunIndex]),
+                                            CurPoint.data(), AppMap.data(),
+                                            const_cast<ConcreteValueBase*>
+                                            (SubExpEvalPoints[PointIdx][j]));
+
+                if (PartialExpression || ConcreteException) {
+                    if (PartialExpression) {
+                        Status |= CONCRETE_EVAL_PART;
+                    }
+                    PartialExpression = ConcreteException = ConcreteOverflow = false;
+                    return false;
+                }
+                ++j;
+            }
         }
+        OverflowedPoints[PointIdx] = ConcreteOverflow;
+        ConcreteOverflow = false;
+        return true;
+    }
+
+    inline bool ConcreteEvaluator::CheckSpecAtPoint(const UserExpressionBase* Spec,
+                                                    GenExpressionBase const* const* Exps,
+                                                    uint32 PointIdx)
+    {
+        ConcreteValueBase Result;
+        Spec->Evaluate(Exps, EvalPoints[PointIdx].data(), &Result);
+        if (UNLIKELY(OverflowedPoints[PointIdx] || ConcreteOverflow)) {
+            // The result need not hold over the unbounded integers,
+            // leave the point to the theorem prover
+            ConcreteOverflow = ConcreteException = false;
+            return true;
+        }
+        if (ConcreteException) {
+            ConcreteException = false;
+            RecordRejection(PointIdx);
+            return false;
+        }
+        if (Result.GetValue() == 0) {
+            RecordRejection(PointIdx);
+            return false;
+        }
+        return true;
     }
 
     void ConcreteEvaluator::AddPoint(const SMTConcreteValueModel& Model)
@@ -102,9 +231,11 @@ namespace ESolver {
         Points.push_back(vector<const ConcreteValueBase*>((size_t)NumBaseAuxVars, nullptr));
         // Add another row to EvalPoints
         EvalPoints.push_back(vector<const ConcreteValueBase*>((size_t)NumTotalAuxVars, nullptr));
+        AddToPointOrder(EvalPoints.size() - 1);
         // Add another row to SubExpEvalPoints
         SubExpEvalPoints.push_back(vector<const ConcreteValueBase*>((size_t)NumSynthFunApps,
                                                                     nullptr));
+        OverflowedPoints.push_back(0);
 
         for(uint32 i = 0; i < NumBaseAuxVars; ++i) {
             auto it = Model.find(BaseAuxVars[i]->GetName());
@@ -160,10 +291,12 @@ namespace ESolver {
         // Add another row to EvalPoints
         if (EvalPoints.size() == 0) {
             EvalPoints.push_back(vector<const ConcreteValueBase*>((size_t)NumTotalAuxVars, nullptr));
+            AddToPointOrder(0);
         }
         // Add another row to SubExpEvalPoints
         SubExpEvalPoints.push_back(vector<const ConcreteValueBase*>((size_t)NumSynthFunApps,
                                                                     nullptr));
+        OverflowedPoints.push_back(0);
 
         for(uint32 i = 0; i < NumBaseAuxVars; ++i) {
             auto it = Model.find(BaseAuxVars[i]->GetName());
@@ -204,38 +337,26 @@ namespace ESolver {
     {
         // Subexpression distinguishability check is valid for this evaluator only
         SigStoreMasterEvalId = ConcEval->GetId();
-        // Recreate the pool for the new size
-        if (SigVecPool != nullptr) {
-            delete SigVecPool;
-            SigVecPool = nullptr;
-        }
-
-        SigVecPool =
-            new boost::pool<>(sizeof(ConcreteValueBase const*) *
-                NumSynthFunApps * (NumPoints));
-
 
         // Clear all the accumulated signatures
-        SigSet.clear();
-        if (SigPool != nullptr) {
-            delete SigPool;
-        }
+        SigStore.Reset(NumPoints * NumSynthFunApps);
+        PackedSigStore.Reset(SignatureStore::GetNumPackedWords(NumPoints * NumSynthFunApps));
+        PackedSigs.clear();
+    }
 
-        SigPool = new boost::pool<>(sizeof(Signature));
+    void ConcreteEvaluator::GetMemoryBreakdown(MemoryBreakdown& Breakdown)
+    {
+        Breakdown.Add("SigStore.NumSignatures", SigStore.GetNumRows() + PackedSigStore.GetNumRows());
+        Breakdown.Add("SigStore.MatrixBytes",
+                      SigStore.GetBytesAllocated() + PackedSigStore.GetBytesAllocated());
+        Breakdown.Add("SigStore.NumPackedSigs", PackedSigs.size());
     }
 
     void ConcreteEvaluator::Finalize()
     {
-        if (SigVecPool != nullptr) {
-            delete SigVecPool;
-            SigVecPool = nullptr;
-        }
-
-        SigSet.clear();
-        if (SigPool != nullptr) {
-            delete SigPool;
-            SigPool = nullptr;
-        }
+        SigStore.Reset(0);
+        PackedSigStore.Reset(0);
+        PackedSigs.clear();
 
         for (uint32 i = 0; i < NumPoints; ++i) {
             for (uint32 j = 0; j < NumSynthFunApps; ++j) {
@@ -255,25 +376,8 @@ namespace ESolver {
         }
 
         for (uint32 i = 0; i < NumPoints; ++i) {
-            auto const& CurPoint = Points[i];
-            uint32 j = 0;
-            for (uint32 SynthFunIndex = 0; SynthFunIndex < NumSynthFuncs; ++SynthFunIndex) {
-                for (auto const& AppMapTargetPos : SynthFunAppMaps[SynthFunIndex]) {
-                    auto const& AppMap = AppMapTargetPos.first;
-                    GenExpressionBase::Evaluate(const_cast<GenExpressionBase*>(Exps[SynthFunIndex]),
-                                                CurPoint.data(), AppMap.data(),
-                                                const_cast<ConcreteValueBase*>
-                                                (SubExpEvalPoints[i][j]));
-
-                    if (PartialExpression || ConcreteException) {
-                        if (PartialExpression) {
-                            Status |= CONCRETE_EVAL_PART;
-                        }
-                        PartialExpression = ConcreteException = false;
-                        return false;
-                    }
-                    ++j;
-                }
+            if (!EvaluateAppsAtPoint(Exps, i, Status)) {
+                return false;
             }
         }
         return true;
@@ -282,19 +386,47 @@ namespace ESolver {
     // returns if subexpression is distinguishable or not
     bool ConcreteEvaluator::CheckSubExpression(GenExpressionBase* Exp,
                                                const ESFixedTypeBase* Type,
-                                               uint32 EvalTypeID, uint32& Status)
+                                               uint32 EvalTypeID, uint32& Status,
+                                               uint32 SynthFunIndex)
     {
-        // expects NumSynthFuncs = 1
-        // return true;
+        // Only the applications of the synth func at SynthFunIndex
+        // are evaluated, the signature is over these applications
         Status |= CONCRETE_EVAL_DIST;
         if (NumPoints == 0) {
             return true;
         }
 
+        auto const& AppMaps = SynthFunAppMaps[SynthFunIndex];
+        const uint32 AppOffset = SynthFunAppOffsets[SynthFunIndex];
+        const uint32 NumApps = AppMaps.size();
+        const bool Packed = (Type->GetBaseType() == BaseTypeBool &&
+                             TheId == ConcreteEvaluator::SigStoreMasterEvalId);
+
+        // Boolean operators over packed subexpressions need not be
+        // evaluated point by point. The values are still written out,
+        // the spec is checked on them
+        const uint32 SigSize = NumPoints * NumApps;
+        if (Packed && PackedSigs.size() > 0) {
+            auto const Words = (uint64*)PackedSigStore.BeginRow();
+            if (EvaluatePacked(Exp, Words, SigSize)) {
+                for (uint32 i = 0; i < NumPoints; ++i) {
+                    const uint32 Offset = i * NumApps;
+                    for (uint32 j = 0; j < NumApps; ++j) {
+                        const uint32 Lane = Offset + j;
+                        const_cast<ConcreteValueBase*>(SubExpEvalPoints[i][AppOffset + j])->
+                            Set(Type, (int64)((Words[Lane / 64] >> (Lane % 64)) & 1));
+                    }
+                    OverflowedPoints[i] = 0;
+                }
+                return InsertSignature(Exp, Type, EvalTypeID, SigSize, true, Status);
+            }
+        }
+
+        bool Overflowed = false;
         for (uint32 i = 0; i < NumPoints; ++i) {
             auto const& CurPoint = Points[i];
-            uint32 j = 0;
-            for (auto const& AppMapTargetPos : SynthFunAppMaps[0]) {
+            uint32 j = AppOffset;
+            for (auto const& AppMapTargetPos : AppMaps) {
                 auto const& AppMap = AppMapTargetPos.first;
                 GenExpressionBase::Evaluate(Exp, CurPoint.data(), AppMap.data(),
                                             const_cast<ConcreteValueBase*>
@@ -304,67 +436,89 @@ namespace ESolver {
                     if (PartialExpression) {
                         Status |= CONCRETE_EVAL_PART;
                     }
-                    PartialExpression = ConcreteException = false;
+                    PartialExpression = ConcreteException = ConcreteOverflow = false;
                     return false;
                 }
                 ++j;
             }
+            OverflowedPoints[i] = ConcreteOverflow;
+            Overflowed = Overflowed || ConcreteOverflow;
+            ConcreteOverflow = false;
         }
 
-        if (TheId != ConcreteEvaluator::SigStoreMasterEvalId) {
+        // Like partial expressions, expressions whose values
+        // wrapped around are distinguishable from everything else
+        if (TheId != ConcreteEvaluator::SigStoreMasterEvalId || Overflowed) {
             return true;
         }
 
         // Check if we have encountered this signature before
-        auto Sig =
-            new (SigPool->malloc()) Signature(NumPoints * NumSynthFunApps,
-                                              EvalTypeID, SigVecPool);
-
-        for (uint32 i = 0; i < NumPoints; ++i) {
-            const uint32 Offset = i * NumSynthFunApps;
-            for (uint32 j = 0; j < NumSynthFunApps; ++j) {
-                (*Sig)[Offset + j] = SubExpEvalPoints[i][j];
+        auto const Row = (Packed ? PackedSigStore.BeginRow() : SigStore.BeginRow());
+        if (Packed) {
+            auto const Words = (uint64*)Row;
+            for (uint32 i = 0; i < NumPoints; ++i) {
+                const uint32 Offset = i * NumApps;
+                for (uint32 j = 0; j < NumApps; ++j) {
+                    const uint32 Lane = Offset + j;
+                    if (SubExpEvalPoints[i][AppOffset + j]->GetValue() != 0) {
+                        Words[Lane / 64] |= ((uint64)1 << (Lane % 64));
+                    }
+                }
+            }
+        } else {
+            for (uint32 i = 0; i < NumPoints; ++i) {
+                const uint32 Offset = i * NumApps;
+                for (uint32 j = 0; j < NumApps; ++j) {
+                    Row[Offset + j] = SubExpEvalPoints[i][AppOffset + j]->GetValue();
+                }
             }
         }
 
+        return InsertSignature(Exp, Type, EvalTypeID, SigSize, Packed, Status);
+    }
+
+    // The signature is in the staging row of the store
+    inline bool ConcreteEvaluator::InsertSignature(const GenExpressionBase* Exp,
+                                                   const ESFixedTypeBase* Type,
+                                                   uint32 EvalTypeID, uint32 Size,
+                                                   bool Packed, uint32& Status)
+    {
         // Have we seen this signature before?
-        if (SigSet.find(Sig) != SigSet.end()) {
-            SigVecPool->free(Sig->ValVec);
-            SigPool->free(Sig);
+        uint32 Row;
+        auto& Store = (Packed ? PackedSigStore : SigStore);
+        if (!Store.CommitRow(EvalTypeID, Type->GetID(), Size, Row)) {
             Status &= ~(CONCRETE_EVAL_DIST);
             return false;
-        } else {
-            // Canonicalize and insert
-            for (uint32 i = 0; i < NumPoints * NumSynthFunApps; ++i) {
-                auto CurVal = (*Sig)[i];
-                (*Sig)[i] = Solver->CreateValue(CurVal->GetType(), CurVal->GetValue());
-            }
-            SigSet.insert(Sig);
-            return true;
         }
+        if (Packed) {
+            // Distinguishable expressions are kept by the enumerator
+            // until the next reset of the store
+            PackedSigs[Exp] = Row;
+        }
+        return true;
     }
 
     bool ConcreteEvaluator::CheckConcreteValidity(GenExpressionBase const* const* Exps,
                                                   ESFixedTypeBase const* const* Types,
-                                                  uint32 const* ExpansionTypeIDs)
+                                                  uint32 const* ExpansionTypeIDs,
+                                                  uint32& Status)
     {
         if (NumPoints == 0) {
+            Status |= CONCRETE_EVAL_DIST;
             return true;
         }
 
-        uint32 Status = 0;
-        CheckSubExpressions(Exps, Types, ExpansionTypeIDs, Status);
-
-        // Check the spec now that the derived aux vars are all created
-        for (uint32 i = 0; i < EvalPoints.size(); ++i) {
-            ConcreteValueBase Result;
-            RewrittenSpec->Evaluate(Exps, EvalPoints[i].data(), &Result);
-            if (ConcreteException) {
-                ConcreteException = false;
+        // No signature is needed for a tuple, so we go point by point,
+        // most rejecting points first: most invalid tuples are
+        // rejected after evaluating them on a few points only
+        Status |= CONCRETE_EVAL_DIST;
+        ReorderPoints();
+        for (auto const i : PointOrder) {
+            if (!EvaluateAppsAtPoint(Exps, i, Status)) {
+                Status &= ~(CONCRETE_EVAL_DIST);
                 return false;
             }
-
-            if (Result.GetValue() == 0) {
+            if (!CheckSpecAtPoint(RewrittenSpec.GetPtr(), Exps, i)) {
                 return false;
             }
         }
@@ -392,20 +546,59 @@ namespace ESolver {
         // Proceed now to evaluate the spec
         // The EvalPoints are already initialized
         // as a side effect of checking subexpression
-        for (uint32 i = 0; i < EvalPoints.size(); ++i) {
-            ConcreteValueBase Result;
-            RewrittenSpec->Evaluate(Arr, EvalPoints[i].data(), &Result);
-            if (ConcreteException) {
-                ConcreteException = false;
-                return false;
-            }
-            if (Result.GetValue() == 0) {
+        ReorderPoints();
+        for (auto const i : PointOrder) {
+            if (!CheckSpecAtPoint(RewrittenSpec.GetPtr(), Arr, i)) {
                 return false;
             }
         }
         return true;
     }
 
+    void ConcreteEvaluator::SetComponentSpecs(const vector<Expression>& Specs)
+    {
+        if (Specs.size() != NumSynthFuncs) {
+            throw InternalError((string)"Internal Error: Expected one spec per synth func " +
+                                "in ConcreteEvaluator::SetComponentSpecs().\nAt: " +
+                                __FILE__ + ":" + to_string(__LINE__));
+        }
+        ComponentSpecs = Specs;
+    }
+
+    bool ConcreteEvaluator::CheckComponentValidity(const GenExpressionBase* Exp,
+                                                   const ESFixedTypeBase* Type,
+                                                   uint32 EvalTypeID,
+                                                   uint32 SynthFunIndex,
+                                                   uint32& Status)
+    {
+        if (NumPoints == 0) {
+            return true;
+        }
+
+        bool Distinguishable = CheckSubExpression(const_cast<GenExpressionBase*>(Exp),
+                                                  Type, EvalTypeID, Status, SynthFunIndex);
+        if (!Distinguishable && !NoDist) {
+            Status &= ~(CONCRETE_EVAL_DIST);
+            return false;
+        }
+
+        // The component spec refers to no synth func other
+        // than the one at SynthFunIndex, the remaining slots
+        // are never looked at
+        ComponentExps[SynthFunIndex] = Exp;
+        auto const& Spec = ComponentSpecs[SynthFunIndex];
+        bool Retval = true;
+        ReorderPoints();
+        for (auto const i : PointOrder) {
+            if (!CheckSpecAtPoint(Spec.GetPtr(), ComponentExps.data(), i)) {
+                Retval = false;
+                break;
+            }
+        }
+        ComponentExps[SynthFunIndex] = nullptr;
+        return Retval;
+    }
+
     bool ConcreteEvaluator::CheckExampleValidity(const UserExpressionBase* Exp)
     {
         auto ExampleValue =
@@ -421,6 +614,66 @@ namespace ESolver {
         return ExampleValue == ResultValue;
     }
 
+    SMTExpr ConcreteEvaluator::MakeConstHoleQuery(const GenExpressionBase* Exp,
+                                                  TheoremProver* TP) const
+    {
+        GenExpressionBase const* Exps[1] = { Exp };
+        vector<SMTExpr> Conjuncts;
+        vector<SMTExpr> PointExprs(NumTotalAuxVars);
+
+        for (uint32 i = 0; i < NumPoints; ++i) {
+            // The base aux vars are fixed by the point, the derived
+            // ones get fresh variables local to this point
+            for (auto const& Op : BaseAuxVars) {
+                PointExprs[Op->GetPosition()] = Points[i][Op->GetPosition()]->ToSMT(TP);
+            }
+            for (auto const& Op : DerivedAuxVars) {
+                PointExprs[Op->GetPosition()] =
+                    TP->CreateVarExpr(Op->GetName() + "_Pt" + to_string(i),
+                                      Op->GetEvalType()->GetSMTType());
+            }
+            // The rewritten spec is (=> Definitions Constraint). The derived
+            // aux vars are functions of the point, so their definitions are
+            // asserted alongside the constraint, an implication would be
+            // satisfied by picking them to falsify the definitions
+            vector<SMTExpr> Assumptions;
+            auto Definitions = RewrittenSpec->GetChildren()[0]->ToSMT(TP, Exps, PointExprs,
+                                                                      Assumptions);
+            auto PointConstraint = RewrittenSpec->GetChildren()[1]->ToSMT(TP, Exps, PointExprs,
+                                                                          Assumptions);
+            Conjuncts.insert(Conjuncts.end(), Assumptions.begin(), Assumptions.end());
+            Conjuncts.push_back(Definitions);
+            Conjuncts.push_back(PointConstraint);
+        }
+
+        if (Conjuncts.size() == 0) {
+            return TP->CreateTrueExpr();
+        }
+        return TP->CreateAndExpr(Conjuncts);
+    }
+
+    void ConcreteEvaluator::GetParamValuations(uint32 SynthFunIndex,
+                                               vector<vector<const ConcreteValueBase*>>& Valuations) const
+    {
+        for (auto const& Point : EvalPoints) {
+            for (auto const& App : SynthFunAppMaps[SynthFunIndex]) {
+                auto const& ArgPositions = App.first;
+                vector<const ConcreteValueBase*> Valuation(ArgPositions.size());
+                bool Complete = true;
+                for (uint32 i = 0; i < ArgPositions.size() && Complete; ++i) {
+                    if (ArgPositions[i] >= NumBaseAuxVars || Point[ArgPositions[i]] == nullptr) {
+                        Complete = false;
+                    } else {
+                        Valuation[i] = Point[ArgPositions[i]];
+                    }
+                }
+                if (Complete) {
+                    Valuations.push_back(Valuation);
+                }
+            }
+        }
+    }
+
     void ConcreteEvaluator::ConcretelyEvaluate(const GenExpressionBase* Exp,
                                                ConcreteValueBase* Result) const
     {
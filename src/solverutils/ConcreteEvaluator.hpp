@@ -43,13 +43,16 @@
 
 #include "../common/ESolverForwardDecls.hpp"
 #include "../expressions/UserExpression.hpp"
-#include <boost/pool/pool.hpp>
 #include "../utils/Hashers.hpp"
 
 #define CONCRETE_EVAL_DIST ((uint32)0x1)
 #define CONCRETE_EVAL_PART ((uint32)0x2)
 #define CONCRETE_EVAL_COMP ((uint32)0x4)
 
+// How often (in number of spec checks) the points are reordered
+// by the number of candidates that they have rejected
+#define CONCRETE_EVAL_REORDER_INTERVAL ((uint32)256)
+
 namespace ESolver {
 
     /*
@@ -69,6 +72,12 @@ namespace ESolver {
         vector<const AuxVarOperator*> DerivedAuxVars;
         vector<vector<pair<vector<uint32>, uint32> > > SynthFunAppMaps;
         vector<const ESFixedTypeBase*> SynthFuncTypes;
+        // Offset of the first application of each synth func
+        // in a row of SubExpEvalPoints
+        vector<uint32> SynthFunAppOffsets;
+        // Per synth func specs, when the spec is separable
+        vector<Expression> ComponentSpecs;
+        vector<GenExpressionBase const*> ComponentExps;
         const uint32 NumBaseAuxVars;
         const uint32 NumDerivedAuxVars;
         const uint32 NumTotalAuxVars;
@@ -77,6 +86,13 @@ namespace ESolver {
         Logger& TheLogger;
         uint32 TheId;
 
+        // The order in which the spec is checked on the EvalPoints.
+        // Points which reject more candidates are moved to the front,
+        // the order of the points within signatures is unaffected.
+        vector<uint32> PointOrder;
+        vector<uint64> PointRejections;
+        uint32 NumChecksSinceReorder;
+
         static uint32 SigStoreMasterEvalId;
         static uint32 NumSynthFunApps;
 
@@ -86,14 +102,34 @@ namespace ESolver {
 
         // Buffers for evaluation of subexpressions
         static vector<vector<const ConcreteValueBase*>> SubExpEvalPoints;
-
-        static SigSetType SigSet;
-
-        // Pool for the signature objects
-        static boost::pool<>* SigPool;
-
-        // The pool for signatures
-        static boost::pool<>* SigVecPool;
+        // Whether integer arithmetic overflowed while filling in
+        // the buffers at a point. Wrapped values cannot reject a
+        // candidate, nor tell subexpressions apart
+        static vector<uint8> OverflowedPoints;
+
+        // The signatures of the distinguishable subexpressions, with
+        // a stride of NumPoints * NumSynthFunApps values. Those of
+        // Boolean subexpressions are packed, and kept apart with
+        // a stride of as many bits
+        static SignatureStore SigStore;
+        static SignatureStore PackedSigStore;
+        // The rows of the packed signatures of the distinguishable
+        // Boolean subexpressions, Boolean operators over them are
+        // evaluated a word at a time
+        static unordered_map<const GenExpressionBase*, uint32> PackedSigs;
+
+        inline void AddToPointOrder(uint32 PointIdx);
+        inline void RecordRejection(uint32 PointIdx);
+        inline void ReorderPoints();
+        inline bool EvaluatePacked(const GenExpressionBase* Exp, uint64* Words, uint32 Size);
+        inline bool InsertSignature(const GenExpressionBase* Exp, const ESFixedTypeBase* Type,
+                                    uint32 EvalTypeID, uint32 Size, bool Packed,
+                                    uint32& Status);
+        inline bool EvaluateAppsAtPoint(GenExpressionBase const* const* Exps,
+                                        uint32 PointIdx, uint32& Status);
+        inline bool CheckSpecAtPoint(const UserExpressionBase* Spec,
+                                     GenExpressionBase const* const* Exps,
+                                     uint32 PointIdx);
 
     public:
         ConcreteEvaluator(ESolver* Solver,
@@ -115,21 +151,45 @@ namespace ESolver {
 
         static void Finalize();
 
+        static void GetMemoryBreakdown(MemoryBreakdown& Breakdown);
+
         // For multiple function synthesis
         bool CheckConcreteValidity(GenExpressionBase const* const* Exps,
                                    ESFixedTypeBase const* const* Types,
-                                   const uint32* ExpansionTypeIDs);
+                                   const uint32* ExpansionTypeIDs,
+                                   uint32& Status);
         // For single function synthesis
         bool CheckConcreteValidity(const GenExpressionBase* Exp,
                                    const ESFixedTypeBase* Type,
                                    uint32 EvalTypeID,
                                    uint32& Status);
 
+        // For separable multiple function synthesis:
+        // checks a single function against its own component of the spec
+        bool CheckComponentValidity(const GenExpressionBase* Exp,
+                                    const ESFixedTypeBase* Type,
+                                    uint32 EvalTypeID,
+                                    uint32 SynthFunIndex,
+                                    uint32& Status);
+
+        void SetComponentSpecs(const vector<Expression>& Specs);
+
         bool CheckExampleValidity(const UserExpressionBase* Exp);
 
+        // Instantiates the spec at every point seen so far, with the
+        // constant holes in Exp left as free variables. A model of the
+        // conjunction gives values for the holes consistent with all points
+        SMTExpr MakeConstHoleQuery(const GenExpressionBase* Exp, TheoremProver* TP) const;
+
+        // The arguments the synth function is applied to at each point,
+        // for the applications whose arguments are all base aux vars
+        void GetParamValuations(uint32 SynthFunIndex,
+                                vector<vector<const ConcreteValueBase*>>& Valuations) const;
+
         bool CheckSubExpression(GenExpressionBase* Exp,
                                 const ESFixedTypeBase* Type,
-                                uint32 EvalTypeID, uint32& Status);
+                                uint32 EvalTypeID, uint32& Status,
+                                uint32 SynthFunIndex = 0);
 
         bool CheckSubExpressions(GenExpressionBase const* const* Exps,
                                  ESFixedTypeBase const* const* Types,
@@ -50,7 +50,6 @@
 #include "../expressions/UserExpression.hpp"
 #include "../containers/ESSmartPtr.hpp"
 #include "../descriptions/GrammarNodes.hpp"
-#include "../values/Signature.hpp"
 
 namespace ESolver {
 
@@ -189,47 +188,6 @@ namespace ESolver {
         }
     };
 
-    class SignaturePtrHasher
-    {
-    public:
-        inline uint64 operator () (const Signature* Ptr) const
-        {
-            if (Ptr == nullptr) {
-                return 0;
-            }
-            return Ptr->Hash();
-        }
-    };
-
-    class SignaturePtrEquals
-    {
-    public:
-        inline bool operator () (const Signature* Ptr1, const Signature* Ptr2) const
-        {
-            // if (Ptr1 == nullptr && Ptr2 == nullptr) {
-            //     return true;
-            // } else if (Ptr1 == nullptr || Ptr2 == nullptr) {
-            //     return false;
-            // }
-            return Ptr1->Equals(*Ptr2);
-        }
-    };
-
-    class SignaturePtrDeepEquals
-    {
-    public:
-        inline bool operator () (const Signature* Ptr1, const Signature* Ptr2) const
-        {
-            if (Ptr1 == nullptr && Ptr2 == nullptr) {
-                return true;
-            } else if (Ptr1 == nullptr || Ptr2 == nullptr) {
-                return false;
-            }
-            return Ptr1->DeepEquals(*Ptr2);
-        }
-    };
-
-
 } /* End namespace */
 
 #endif /* __ESOLVER_HASHERS_HPP */
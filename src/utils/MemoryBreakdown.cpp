@@ -0,0 +1,59 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Implementation of the memory breakdown counters
+//===----------------------------------------------------------------------===//
+
+#include "MemoryBreakdown.hpp"
+
+namespace ESolver {
+
+    MemoryBreakdown::MemoryBreakdown()
+    {
+        // Nothing here
+    }
+
+    MemoryBreakdown::~MemoryBreakdown()
+    {
+        // Nothing here
+    }
+
+    void MemoryBreakdown::Add(const string& Name, uint64 Value)
+    {
+        for (auto& Counter : Counters) {
+            if (Counter.first == Name) {
+                Counter.second += Value;
+                return;
+            }
+        }
+        Counters.push_back(make_pair(Name, Value));
+    }
+
+    const vector<pair<string, uint64>>& MemoryBreakdown::GetCounters() const
+    {
+        return Counters;
+    }
+
+    string MemoryBreakdown::ToJSON() const
+    {
+        ostringstream sstr;
+        sstr << "{";
+        bool First = true;
+        for (auto const& Counter : Counters) {
+            if (!First) {
+                sstr << ",";
+            }
+            First = false;
+            sstr << endl << "    \"" << Counter.first << "\": " << Counter.second;
+        }
+        sstr << endl << "}" << endl;
+        return sstr.str();
+    }
+
+} /* End namespace */
+
+//
+// MemoryBreakdown.cpp ends here
@@ -0,0 +1,39 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Named counters of the memory held by the solver's containers
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "../common/ESolverForwardDecls.hpp"
+
+namespace ESolver {
+
+    // Each subsystem adds the sizes of its pools and tables, in bytes,
+    // or the number of objects they hold. Counters with the same name,
+    // e.g., from the enumerators of several functions, are summed up.
+    // Counters are kept in the order in which they were first added
+    class MemoryBreakdown
+    {
+    private:
+        vector<pair<string, uint64>> Counters;
+
+    public:
+        MemoryBreakdown();
+        ~MemoryBreakdown();
+
+        void Add(const string& Name, uint64 Value);
+        const vector<pair<string, uint64>>& GetCounters() const;
+
+        // One flat JSON object, counter names are the keys
+        string ToJSON() const;
+    };
+
+} /* End namespace */
+
+//
+// MemoryBreakdown.hpp ends here
@@ -43,6 +43,8 @@
 #include "../descriptions/ESType.hpp"
 #include "../utils/TextUtils.hpp"
 #include "../z3interface/TheoremProver.hpp"
+#include "WideBitVector.hpp"
+#include "StringStore.hpp"
 
 namespace ESolver {
 
@@ -73,6 +75,20 @@ namespace ESolver {
     {
         HashValue = (uint64)0;
         boost::hash_combine(HashValue, Type->Hash());
+        // Hash the bits of wide bitvectors rather than their handles,
+        // which depend on the order in which values were interned
+        if (Type->GetBaseType() == BaseTypeBitVector &&
+            WideBV::IsWide(static_cast<const ESBVType*>(Type)->GetSize())) {
+            for (auto Limb : static_cast<const ESBVType*>(Type)->GetStore()->Get(TheValue)) {
+                boost::hash_combine(HashValue, Limb);
+            }
+            return;
+        }
+        if (Type->GetBaseType() == BaseTypeString) {
+            boost::hash_combine(HashValue,
+                                static_cast<const ESStringType*>(Type)->GetStore()->Hash(TheValue));
+            return;
+        }
         boost::hash_combine(HashValue, TheValue);
         return;
     }
@@ -101,6 +117,9 @@ namespace ESolver {
         ostringstream sstr;
         auto Type = static_cast<const ESBVType*>(this->Type);
         auto Size = Type->GetSize();
+        if (WideBV::IsWide(Size)) {
+            return WideBV::ToString(Type->GetStore()->Get(TheValue), Size);
+        }
         if (Size % 4 == 0) {
             sstr << "#x" << setw(Size/4) << setfill('0') << hex << TheValue;
         } else {
@@ -122,6 +141,10 @@ namespace ESolver {
         return sstr.str();
     }
 
+    inline string ConcreteValueBase::StringToString(bool Simple) const
+    {
+        return static_cast<const ESStringType*>(Type)->GetStore()->ToLiteral(TheValue);
+    }
 
     inline string ConcreteValueBase::EnumTypeToString(bool Simple) const
     {
@@ -144,6 +167,8 @@ namespace ESolver {
             return EnumTypeToString();
         case BaseTypeBitVector:
             return BVToString();
+        case BaseTypeString:
+            return StringToString();
         default:
             return "(Undefined: due to weird type)";
         }
@@ -165,6 +190,8 @@ namespace ESolver {
             return EnumTypeToString(true);
         case BaseTypeBitVector:
             return BVToString(true);
+        case BaseTypeString:
+            return StringToString(true);
         default:
             return "(Undefined: due to weird type)";
         }
@@ -195,7 +222,17 @@ namespace ESolver {
 
     inline SMTExpr ConcreteValueBase::BVToSMT(TheoremProver* TP) const
     {
-        return TP->CreateBVConstant(*(uint64*)&TheValue, static_cast<const ESBVType*>(Type)->GetSize());
+        auto Type = static_cast<const ESBVType*>(this->Type);
+        auto Size = Type->GetSize();
+        if (WideBV::IsWide(Size)) {
+            return TP->CreateBVConstant(Type->GetStore()->Get(TheValue), Size);
+        }
+        return TP->CreateBVConstant(*(uint64*)&TheValue, Size);
+    }
+
+    inline SMTExpr ConcreteValueBase::StringToSMT(TheoremProver* TP) const
+    {
+        return TP->CreateStringConstant(static_cast<const ESStringType*>(Type)->GetStore()->Get(TheValue));
     }
 
     SMTExpr ConcreteValueBase::ToSMT(TheoremProver* TP) const
@@ -209,6 +246,8 @@ namespace ESolver {
             return EnumTypeToSMT(TP);
         case BaseTypeBitVector:
             return BVToSMT(TP);
+        case BaseTypeString:
+            return StringToSMT(TP);
         default:
             assert(false);
         }
@@ -73,11 +73,13 @@ namespace ESolver {
         inline string BoolToString(bool Simple = false) const;
         inline string EnumTypeToString(bool Simple = false) const;
         inline string BVToString(bool Simple = false) const;
+        inline string StringToString(bool Simple = false) const;
 
         inline SMTExpr IntToSMT(TheoremProver* TP) const;
         inline SMTExpr BoolToSMT(TheoremProver* TP) const;
         inline SMTExpr EnumTypeToSMT(TheoremProver* TP) const;
         inline SMTExpr BVToSMT(TheoremProver* TP) const;
+        inline SMTExpr StringToSMT(TheoremProver* TP) const;
 
     protected:
         void ComputeHashValue() const;
@@ -0,0 +1,147 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Implementation of the signature store
+//===----------------------------------------------------------------------===//
+
+#include "SignatureStore.hpp"
+#include "../exceptions/ESException.hpp"
+#include "../external/spookyhash/SpookyHash.hpp"
+#include <cstring>
+
+#if defined ESOLVER_HUGE_PAGE_ARENAS
+#include <sys/mman.h>
+#endif
+
+#define ESOLVER_SIG_TABLE_INITIAL_SIZE (1024)
+#define ESOLVER_SIG_TABLE_EMPTY_SLOT (UINT64_MAX)
+#define ESOLVER_SIG_STORE_MAX_ROWS ((uint64)1 << 31)
+
+namespace ESolver {
+
+    SignatureStore::SignatureStore()
+        : Stride(0), NumRows(0),
+          Slots(ESOLVER_SIG_TABLE_INITIAL_SIZE, ESOLVER_SIG_TABLE_EMPTY_SLOT)
+    {
+        // Nothing here
+    }
+
+    SignatureStore::~SignatureStore()
+    {
+        // Nothing here
+    }
+
+    inline void SignatureStore::GrowValues()
+    {
+        const uint64 Needed = ((uint64)NumRows + 1) * Stride;
+        if (Needed <= Values.size()) {
+            return;
+        }
+        Values.resize(max(Needed, (uint64)Values.size() * 2));
+
+#if defined ESOLVER_HUGE_PAGE_ARENAS && defined MADV_HUGEPAGE
+        // Large vectors are mapped by the allocator, the huge pages
+        // fully inside the matrix can be backed by huge pages as well
+        const uint64 HugePageSize = (uint64)1 << 21;
+        const uint64 Begin = ((uint64)Values.data() + HugePageSize - 1) & ~(HugePageSize - 1);
+        const uint64 End = ((uint64)(Values.data() + Values.size())) & ~(HugePageSize - 1);
+        if (Begin < End) {
+            madvise((void*)Begin, End - Begin, MADV_HUGEPAGE);
+        }
+#endif /* ESOLVER_HUGE_PAGE_ARENAS */
+    }
+
+    inline void SignatureStore::GrowSlots()
+    {
+        vector<uint64> OldSlots(Slots.size() * 2, ESOLVER_SIG_TABLE_EMPTY_SLOT);
+        OldSlots.swap(Slots);
+        const uint64 Mask = Slots.size() - 1;
+        for (auto const& OldSlot : OldSlots) {
+            if (OldSlot == ESOLVER_SIG_TABLE_EMPTY_SLOT) {
+                continue;
+            }
+            uint64 Index = (OldSlot >> 32) & Mask;
+            while (Slots[Index] != ESOLVER_SIG_TABLE_EMPTY_SLOT) {
+                Index = (Index + 1) & Mask;
+            }
+            Slots[Index] = OldSlot;
+        }
+    }
+
+    void SignatureStore::Reset(uint32 Stride)
+    {
+        this->Stride = Stride;
+        NumRows = 0;
+        Values.clear();
+        Keys.clear();
+        vector<uint64>(ESOLVER_SIG_TABLE_INITIAL_SIZE, ESOLVER_SIG_TABLE_EMPTY_SLOT).swap(Slots);
+    }
+
+    int64* SignatureStore::BeginRow()
+    {
+        GrowValues();
+        auto Row = Values.data() + (uint64)NumRows * Stride;
+        memset(Row, 0, sizeof(int64) * Stride);
+        return Row;
+    }
+
+    bool SignatureStore::CommitRow(uint32 ExpTypeID, TypeID ValueTypeID, uint32 Size,
+                                   uint32& Row)
+    {
+        const RowKey Key = { ValueTypeID, ExpTypeID, Size };
+        const int64* Staged = GetRow(NumRows);
+        uint64 Seed = ((uint64)ExpTypeID << 32) ^ ValueTypeID;
+        Seed ^= (uint64)Size * 0x9E3779B97F4A7C15ULL;
+        const uint64 Tag = SpookyHash::SpookyHash::Hash64(Staged, sizeof(int64) * Stride, Seed) >> 32;
+
+        const uint64 Mask = Slots.size() - 1;
+        uint64 Index = Tag & Mask;
+        while (Slots[Index] != ESOLVER_SIG_TABLE_EMPTY_SLOT) {
+            const uint64 Slot = Slots[Index];
+            const uint32 Other = (uint32)Slot;
+            auto const& OtherKey = Keys[Other];
+            if ((Slot >> 32) == Tag &&
+                OtherKey.ExpTypeID == ExpTypeID && OtherKey.ValueTypeID == ValueTypeID &&
+                OtherKey.Size == Size &&
+                memcmp(GetRow(Other), Staged, sizeof(int64) * Stride) == 0) {
+                Row = Other;
+                return false;
+            }
+            Index = (Index + 1) & Mask;
+        }
+
+        if (UNLIKELY(NumRows >= ESOLVER_SIG_STORE_MAX_ROWS)) {
+            throw OutOfMemoryException((string)"Signature store is out of row indices");
+        }
+        Row = NumRows++;
+        Keys.push_back(Key);
+        Slots[Index] = (Tag << 32) | Row;
+        if ((uint64)NumRows * 2 > Slots.size()) {
+            GrowSlots();
+        }
+        return true;
+    }
+
+    uint32 SignatureStore::GetStride() const
+    {
+        return Stride;
+    }
+
+    uint64 SignatureStore::GetNumRows() const
+    {
+        return NumRows;
+    }
+
+    uint64 SignatureStore::GetBytesAllocated() const
+    {
+        return (Values.capacity() * sizeof(int64) + Keys.capacity() * sizeof(RowKey) +
+                Slots.capacity() * sizeof(uint64));
+    }
+
+} /* End namespace */
+
+//
+// SignatureStore.cpp ends here
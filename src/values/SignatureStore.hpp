@@ -0,0 +1,83 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Storage for the signatures of the distinguishable subexpressions
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "../common/ESolverForwardDecls.hpp"
+
+namespace ESolver {
+
+    // The signatures of one evaluation epoch, i.e., between two resets,
+    // are the rows of one int64 matrix with a fixed stride, which is the
+    // largest number of words in a signature. A row holds the raw values
+    // of the subexpression at each point and application, or, in a store
+    // of packed signatures, a bitset of them, 64 values to a word. Unused
+    // words of a row are zero, so rows are compared over the full stride.
+    // A new signature is written to the staging row, past the last row,
+    // and becomes a row of the matrix if no equal signature exists.
+    // Rows are found through an open addressing table on their hash,
+    // kept at most half full
+    class SignatureStore
+    {
+    private:
+        // Signatures are only equal if their keys are equal
+        struct RowKey
+        {
+            TypeID ValueTypeID;
+            uint32 ExpTypeID;
+            uint32 Size;
+        };
+
+        uint32 Stride;
+        uint32 NumRows;
+        vector<int64> Values;
+        vector<RowKey> Keys;
+        // The upper half of the hash of a row, and its index.
+        // The upper half of the hash also gives the initial slot
+        vector<uint64> Slots;
+
+        inline void GrowValues();
+        inline void GrowSlots();
+
+    public:
+        SignatureStore();
+        ~SignatureStore();
+
+        // Drops all the rows and sets the stride for the next epoch
+        void Reset(uint32 Stride);
+
+        // A zeroed row of Stride values, for the values of the new
+        // signature. Invalidated by the next call to BeginRow()
+        int64* BeginRow();
+        // Makes the staging row a row of the matrix, unless an equal
+        // signature exists. Returns true and the index of the new row
+        // in Row if the signature is new, and false and the index of
+        // the equal row otherwise
+        bool CommitRow(uint32 ExpTypeID, TypeID ValueTypeID, uint32 Size, uint32& Row);
+
+        // Invalidated by the next call to BeginRow()
+        inline const int64* GetRow(uint32 Row) const
+        {
+            return Values.data() + (uint64)Row * Stride;
+        }
+
+        uint32 GetStride() const;
+        uint64 GetNumRows() const;
+        uint64 GetBytesAllocated() const;
+
+        static inline uint32 GetNumPackedWords(uint32 Size)
+        {
+            return (Size + 63) / 64;
+        }
+    };
+
+} /* End namespace */
+
+//
+// SignatureStore.hpp ends here
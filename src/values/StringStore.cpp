@@ -0,0 +1,303 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Implementation of the string store
+//===----------------------------------------------------------------------===//
+
+#include "StringStore.hpp"
+#include "../exceptions/ESException.hpp"
+#include "../utils/MemoryBreakdown.hpp"
+#include "../external/spookyhash/SpookyHash.hpp"
+#include <cstring>
+#include <cctype>
+
+namespace ESolver {
+
+    static inline uint64 HashChars(const char* Chars, uint32 Length)
+    {
+        return SpookyHash::SpookyHash::Hash64(Chars, Length, (uint64)0);
+    }
+
+    StringStore::StringStore()
+        : BuildOffset(0)
+    {
+        // Nothing here
+    }
+
+    StringStore::~StringStore()
+    {
+        // Nothing here
+    }
+
+    inline void StringStore::InsertSlot(int64 Handle)
+    {
+        const uint64 Mask = Slots.size() - 1;
+        uint64 Slot = Spans[Handle].Hash & Mask;
+        while (Slots[Slot] != -1) {
+            Slot = (Slot + 1) & Mask;
+        }
+        Slots[Slot] = Handle;
+    }
+
+    inline void StringStore::GrowSlots()
+    {
+        uint64 NewSize = 1024;
+        while (NewSize < (GetNumStrings() + 1) * 2) {
+            NewSize *= 2;
+        }
+        Slots.assign(NewSize, (int64)-1);
+        vector<bool> Free(Spans.size(), false);
+        for (auto Handle : FreeHandles) {
+            Free[Handle] = true;
+        }
+        for (int64 i = 0; i < (int64)Spans.size(); ++i) {
+            if (!Free[i]) {
+                InsertSlot(i);
+            }
+        }
+    }
+
+    int64 StringStore::Intern(const char* Chars, uint32 Length)
+    {
+        BeginString();
+        AppendChars(Chars, Length);
+        return CommitString();
+    }
+
+    int64 StringStore::Intern(const string& Str)
+    {
+        return Intern(Str.data(), Str.length());
+    }
+
+    int64 StringStore::GetEmpty()
+    {
+        return Intern(nullptr, 0);
+    }
+
+    void StringStore::BeginString()
+    {
+        BuildOffset = Arena.size();
+    }
+
+    void StringStore::AppendChars(const char* Chars, uint32 Length)
+    {
+        if (Length == 0) {
+            return;
+        }
+        // Chars may point into the arena itself, which moves
+        // when it grows
+        const char* ArenaBegin = Arena.data();
+        const bool InArena = (Chars >= ArenaBegin && Chars < ArenaBegin + Arena.size());
+        const uint64 SourceOffset = InArena ? (uint64)(Chars - ArenaBegin) : 0;
+        const uint64 Offset = Arena.size();
+        Arena.resize(Offset + Length);
+        if (InArena) {
+            Chars = Arena.data() + SourceOffset;
+        }
+        memcpy(Arena.data() + Offset, Chars, Length);
+    }
+
+    int64 StringStore::CommitString()
+    {
+        if ((GetNumStrings() + 1) * 2 > Slots.size()) {
+            GrowSlots();
+        }
+
+        const char* Chars = Arena.data() + BuildOffset;
+        const uint32 Length = Arena.size() - BuildOffset;
+        const uint64 Hash = HashChars(Chars, Length);
+        const uint64 Mask = Slots.size() - 1;
+        uint64 Slot = Hash & Mask;
+        while (Slots[Slot] != -1) {
+            auto const& Span = Spans[Slots[Slot]];
+            if (Span.Hash == Hash && Span.Length == Length &&
+                (Length == 0 || memcmp(Arena.data() + Span.Offset, Chars, Length) == 0)) {
+                Arena.resize(BuildOffset);
+                return Slots[Slot];
+            }
+            Slot = (Slot + 1) & Mask;
+        }
+
+        int64 Handle;
+        if (FreeHandles.size() > 0) {
+            Handle = FreeHandles.back();
+            FreeHandles.pop_back();
+            Spans[Handle] = { BuildOffset, Length, Hash };
+        } else {
+            Handle = Spans.size();
+            Spans.push_back({ BuildOffset, Length, Hash });
+        }
+        Slots[Slot] = Handle;
+        return Handle;
+    }
+
+    const char* StringStore::GetChars(int64 Handle) const
+    {
+        return Arena.data() + Spans[Handle].Offset;
+    }
+
+    uint32 StringStore::GetLength(int64 Handle) const
+    {
+        return Spans[Handle].Length;
+    }
+
+    string StringStore::Get(int64 Handle) const
+    {
+        return string(GetChars(Handle), GetLength(Handle));
+    }
+
+    uint64 StringStore::Hash(int64 Handle) const
+    {
+        return Spans[Handle].Hash;
+    }
+
+    uint64 StringStore::GetNumStrings() const
+    {
+        return Spans.size() - FreeHandles.size();
+    }
+
+    void StringStore::Retain(const vector<int64>& Handles)
+    {
+        vector<bool> Kept(Spans.size(), false);
+        uint64 NumChars = 0;
+        int64 LastHandle = -1;
+        for (auto Handle : Handles) {
+            if (!Kept[Handle]) {
+                Kept[Handle] = true;
+                NumChars += Spans[Handle].Length;
+                LastHandle = max(LastHandle, Handle);
+            }
+        }
+
+        // Copy the kept strings to a fresh arena, so that the
+        // memory of the dropped ones is released
+        vector<char> NewArena;
+        NewArena.reserve(NumChars);
+        for (int64 i = 0; i <= LastHandle; ++i) {
+            if (Kept[i]) {
+                auto& Span = Spans[i];
+                const uint64 Offset = NewArena.size();
+                NewArena.insert(NewArena.end(), Arena.begin() + Span.Offset,
+                                Arena.begin() + Span.Offset + Span.Length);
+                Span.Offset = Offset;
+            }
+        }
+        Arena.swap(NewArena);
+        Spans.resize(LastHandle + 1);
+        FreeHandles.clear();
+        for (int64 i = LastHandle - 1; i >= 0; --i) {
+            if (!Kept[i]) {
+                FreeHandles.push_back(i);
+            }
+        }
+        Slots.clear();
+        GrowSlots();
+    }
+
+    static inline uint32 HexDigitValue(char Digit)
+    {
+        if (Digit >= '0' && Digit <= '9') {
+            return Digit - '0';
+        }
+        return tolower(Digit) - 'a' + 10;
+    }
+
+    int64 StringStore::ParseLiteral(const string& Literal)
+    {
+        const uint32 Length = Literal.length();
+        if (Length < 2 || Literal[0] != '"' || Literal[Length - 1] != '"') {
+            throw TypeException((string)"Invalid string literal: " + Literal);
+        }
+
+        string Chars;
+        for (uint32 i = 1; i < Length - 1; ++i) {
+            if (Literal[i] == '"') {
+                if (i + 1 >= Length - 1 || Literal[i + 1] != '"') {
+                    throw TypeException((string)"Unescaped quote in string literal: " + Literal);
+                }
+                Chars.push_back('"');
+                ++i;
+                continue;
+            }
+            if (Literal[i] != '\\' || i + 1 >= Length - 1 || Literal[i + 1] != 'u') {
+                Chars.push_back(Literal[i]);
+                continue;
+            }
+
+            // \uDDDD or \u{D} to \u{DDDDD}, anything else
+            // is a literal backslash
+            uint32 First = i + 2, Last;
+            const bool Braced = (First < Length - 1 && Literal[First] == '{');
+            if (Braced) {
+                ++First;
+                Last = First;
+                while (Last < Length - 1 && Last - First < 5 && isxdigit(Literal[Last])) {
+                    ++Last;
+                }
+                if (Last == First || Last >= Length - 1 || Literal[Last] != '}') {
+                    Chars.push_back(Literal[i]);
+                    continue;
+                }
+            } else {
+                Last = First;
+                while (Last < Length - 1 && Last - First < 4 && isxdigit(Literal[Last])) {
+                    ++Last;
+                }
+                if (Last - First != 4) {
+                    Chars.push_back(Literal[i]);
+                    continue;
+                }
+            }
+
+            uint32 CodePoint = 0;
+            for (uint32 j = First; j < Last; ++j) {
+                CodePoint = (CodePoint << 4) | HexDigitValue(Literal[j]);
+            }
+            if (CodePoint > 0xFF) {
+                throw UnimplementedException((string)"Characters beyond \\u{ff} are not " +
+                                             "supported in string literals: " + Literal);
+            }
+            Chars.push_back((char)CodePoint);
+            i = Braced ? Last : Last - 1;
+        }
+        return Intern(Chars);
+    }
+
+    string StringStore::Quote(const char* Chars, uint32 Length)
+    {
+        ostringstream sstr;
+        sstr << '"';
+        for (uint32 i = 0; i < Length; ++i) {
+            const unsigned char Char = Chars[i];
+            if (Char == '"') {
+                sstr << "\"\"";
+            } else if (Char >= 0x20 && Char < 0x7F && Char != '\\') {
+                sstr << Char;
+            } else {
+                sstr << "\\u{" << hex << (uint32)Char << dec << "}";
+            }
+        }
+        sstr << '"';
+        return sstr.str();
+    }
+
+    string StringStore::ToLiteral(int64 Handle) const
+    {
+        return Quote(GetChars(Handle), GetLength(Handle));
+    }
+
+    void StringStore::GetMemoryBreakdown(MemoryBreakdown& Breakdown) const
+    {
+        Breakdown.Add("StringStore.NumStrings", GetNumStrings());
+        Breakdown.Add("StringStore.ArenaBytes", Arena.capacity());
+        Breakdown.Add("StringStore.SpanBytes", Spans.capacity() * sizeof(StringSpan));
+        Breakdown.Add("StringStore.SlotBytes", Slots.capacity() * sizeof(int64));
+    }
+
+} /* End namespace */
+
+//
+// StringStore.cpp ends here
@@ -0,0 +1,88 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Interned storage for the values of the String sort
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "../common/ESolverForwardDecls.hpp"
+
+namespace ESolver {
+
+    // String values are interned here and a ConcreteValueBase holds
+    // the handle of its string, so that values and signatures over
+    // strings hash and compare as single words, like all other types.
+    // The characters of all strings live back to back in one arena,
+    // indexed by an open addressing table on their contents. Equal
+    // strings get equal handles. Each solver owns a store, which its
+    // String type points to. Strings computed during an enumeration
+    // are dropped by Retain() when the enumeration restarts
+    class StringStore
+    {
+    private:
+        struct StringSpan
+        {
+            uint64 Offset;
+            uint32 Length;
+            uint64 Hash;
+        };
+
+        vector<char> Arena;
+        vector<StringSpan> Spans;
+        // Linear probing on the hash of the characters. Slots hold
+        // handles, -1 marks an empty slot. Kept at most half full
+        vector<int64> Slots;
+        // Handles of dropped strings, reused for new ones
+        vector<int64> FreeHandles;
+        // Where the string being built starts in the arena
+        uint64 BuildOffset;
+
+        inline void InsertSlot(int64 Handle);
+        inline void GrowSlots();
+
+    public:
+        StringStore();
+        ~StringStore();
+
+        int64 Intern(const char* Chars, uint32 Length);
+        int64 Intern(const string& Str);
+        int64 GetEmpty();
+
+        // Strings computed from other strings are built in place, past
+        // the end of the arena, and interned by CommitString(). The
+        // characters appended may be those of interned strings
+        void BeginString();
+        void AppendChars(const char* Chars, uint32 Length);
+        int64 CommitString();
+
+        // The pointer is invalidated by the next call to Intern()
+        // or AppendChars()
+        const char* GetChars(int64 Handle) const;
+        uint32 GetLength(int64 Handle) const;
+        string Get(int64 Handle) const;
+        // Hash of the characters, independent of the interning order
+        uint64 Hash(int64 Handle) const;
+        uint64 GetNumStrings() const;
+
+        // Drops all strings but those of the given handles, which
+        // keep their handles. Other handles are invalid afterwards
+        void Retain(const vector<int64>& Handles);
+
+        // SMT-LIB literals: enclosed in double quotes, with a quote
+        // written as two quotes and other non printable characters
+        // written as \u{..} escapes
+        int64 ParseLiteral(const string& Literal);
+        string ToLiteral(int64 Handle) const;
+        static string Quote(const char* Chars, uint32 Length);
+
+        void GetMemoryBreakdown(MemoryBreakdown& Breakdown) const;
+    };
+
+} /* End namespace */
+
+//
+// StringStore.hpp ends here
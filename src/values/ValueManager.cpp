@@ -40,31 +40,97 @@
 
 #include "ValueManager.hpp"
 #include "ConcreteValueBase.hpp"
+#include "../descriptions/ESType.hpp"
+#include "../utils/MemoryBreakdown.hpp"
+
+// The small values are those in [MIN, MIN + COUNT)
+#define ESOLVER_SMALL_VALUE_MIN ((int64)-256)
+#define ESOLVER_SMALL_VALUE_COUNT ((int64)1280)
+#define ESOLVER_SMALL_VALUE_MAX_TYPE_ID ((TypeID)1024)
+#define ESOLVER_VALUE_TABLE_INITIAL_SIZE (4096)
 
 namespace ESolver {
 
+    static inline uint64 HashValueKey(TypeID ID, int64 TheValue)
+    {
+        uint64 Retval = ((uint64)TheValue) ^ (ID * 0x9E3779B97F4A7C15ULL);
+        Retval ^= Retval >> 33;
+        Retval *= 0xFF51AFD7ED558CCDULL;
+        Retval ^= Retval >> 33;
+        return Retval;
+    }
+
     ValueManager::ValueManager()
+        : Slots(ESOLVER_VALUE_TABLE_INITIAL_SIZE, ValueSlot { 0, 0, nullptr }),
+          NumValues(0)
     {
-        // CVSet.set_empty_key(NULL);
-        ValuePool = new boost::pool<>(sizeof(ConcreteValueBase));
+        // Nothing here
     }
-    
+
     ValueManager::~ValueManager()
     {
-        delete ValuePool;
+        // Nothing here
+    }
+
+    inline void ValueManager::GrowSlots()
+    {
+        vector<ValueSlot> OldSlots(Slots.size() * 2, ValueSlot { 0, 0, nullptr });
+        OldSlots.swap(Slots);
+        const uint64 Mask = Slots.size() - 1;
+        for (auto const& OldSlot : OldSlots) {
+            if (OldSlot.Value == nullptr) {
+                continue;
+            }
+            uint64 Index = HashValueKey(OldSlot.ID, OldSlot.TheValue) & Mask;
+            while (Slots[Index].Value != nullptr) {
+                Index = (Index + 1) & Mask;
+            }
+            Slots[Index] = OldSlot;
+        }
+    }
+
+    inline const ConcreteValueBase* ValueManager::Intern(const ESFixedTypeBase* Type,
+                                                         int64 TheValue)
+    {
+        const TypeID ID = Type->GetID();
+        const uint64 Mask = Slots.size() - 1;
+        uint64 Index = HashValueKey(ID, TheValue) & Mask;
+        while (Slots[Index].Value != nullptr) {
+            auto const& Slot = Slots[Index];
+            if (Slot.TheValue == TheValue && Slot.ID == ID) {
+                return Slot.Value;
+            }
+            Index = (Index + 1) & Mask;
+        }
+
+        auto Retval = new (ValueArena.Allocate(sizeof(ConcreteValueBase))) ConcreteValueBase(Type, TheValue);
+        Slots[Index] = ValueSlot { TheValue, ID, Retval };
+        if (++NumValues * 2 > Slots.size()) {
+            GrowSlots();
+        }
+        return Retval;
     }
 
     const ConcreteValueBase* ValueManager::GetValue(const ESFixedTypeBase* Type, int64 TheValue)
     {
-        ConcreteValueBase ThisValue(Type, TheValue);
-        auto CachedIt = CVSet.find(&ThisValue);
-        if(CachedIt != CVSet.end()) {
-            return *CachedIt;
-        } else {
-            auto Retval = new (ValuePool->malloc()) ConcreteValueBase(Type, TheValue);
-            CVSet.insert(Retval);
-            return Retval;
+        const TypeID ID = Type->GetID();
+        const uint64 Offset = (uint64)(TheValue - ESOLVER_SMALL_VALUE_MIN);
+        if (Offset >= (uint64)ESOLVER_SMALL_VALUE_COUNT || ID >= ESOLVER_SMALL_VALUE_MAX_TYPE_ID) {
+            return Intern(Type, TheValue);
+        }
+
+        if (ID >= SmallValues.size()) {
+            SmallValues.resize(ID + 1);
         }
+        auto& TypeValues = SmallValues[ID];
+        if (TypeValues.size() == 0) {
+            TypeValues.resize(ESOLVER_SMALL_VALUE_COUNT, nullptr);
+        }
+        auto& Retval = TypeValues[Offset];
+        if (Retval == nullptr) {
+            Retval = Intern(Type, TheValue);
+        }
+        return Retval;
     }
 
     const ConcreteValueBase* ValueManager::GetValueNT(const ESFixedTypeBase* Type,
@@ -74,14 +140,31 @@ namespace ESolver {
         return ThisValue;
     }
 
+    void ValueManager::GetValuesOfType(const ESFixedTypeBase* Type, vector<int64>& Values) const
+    {
+        const TypeID ID = Type->GetID();
+        for (auto const& Slot : Slots) {
+            if (Slot.Value != nullptr && Slot.ID == ID) {
+                Values.push_back(Slot.TheValue);
+            }
+        }
+    }
+
     void ValueManager::Clear()
     {
-        // Deleting the pool will clear all the values
+        // Deleting the arena will clear all the values
     }
 
     uint64 ValueManager::GetNumConcreteValues() const
     {
-        return CVSet.size();
+        return NumValues;
+    }
+
+    void ValueManager::GetMemoryBreakdown(MemoryBreakdown& Breakdown) const
+    {
+        Breakdown.Add("ValueManager.NumValues", NumValues);
+        Breakdown.Add("ValueManager.ValueArenaBytes", ValueArena.GetBytesAllocated());
+        Breakdown.Add("ValueManager.SlotBytes", Slots.size() * sizeof(ValueSlot));
     }
 
 } /* End namespace */
@@ -43,15 +43,35 @@
 
 #include "../common/ESolverForwardDecls.hpp"
 #include "../utils/Hashers.hpp"
-#include <boost/pool/pool.hpp>
+#include "../containers/BumpArena.hpp"
 
 namespace ESolver {
 
+    // Values are interned in an open addressing table keyed by the
+    // type id and the value, probed linearly and kept at most half
+    // full. The keys are stored in the slots, so that a lookup does
+    // not touch the values themselves. Small values of each type are
+    // also cached in a direct mapped array, indexed by type id, which
+    // covers the booleans and the small integers
     class ValueManager
     {
     private:
-        ConcreteValueSet CVSet;
-        boost::pool<>* ValuePool;
+        struct ValueSlot
+        {
+            int64 TheValue;
+            TypeID ID;
+            const ConcreteValueBase* Value;
+        };
+
+        vector<ValueSlot> Slots;
+        uint64 NumValues;
+        vector<vector<const ConcreteValueBase*>> SmallValues;
+        // Values are never freed individually or on reset, they
+        // live as long as the ValueManager
+        BumpArena ValueArena;
+
+        inline void GrowSlots();
+        inline const ConcreteValueBase* Intern(const ESFixedTypeBase* Type, int64 TheValue);
 
     public:
         ValueManager();
@@ -59,11 +79,14 @@ namespace ESolver {
 
         const ConcreteValueBase* GetValue(const ESFixedTypeBase* Type, int64 TheValue);
         const ConcreteValueBase* GetValueNT(const ESFixedTypeBase* Type, int64 TheValue);
+        // Appends the raw values of all values of the type
+        void GetValuesOfType(const ESFixedTypeBase* Type, vector<int64>& Values) const;
 
         void Clear();
 
         // stats
         uint64 GetNumConcreteValues() const;
+        void GetMemoryBreakdown(MemoryBreakdown& Breakdown) const;
     };
 
 } /* End namespace */
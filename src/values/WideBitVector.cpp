@@ -0,0 +1,496 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Implementation of the wide bitvector store and kernels
+//===----------------------------------------------------------------------===//
+
+#include "WideBitVector.hpp"
+#include "../exceptions/ESException.hpp"
+#include "../utils/MemoryBreakdown.hpp"
+#include <cctype>
+
+namespace ESolver {
+
+    WideBVStore::WideBVStore()
+    {
+        // Nothing here
+    }
+
+    WideBVStore::~WideBVStore()
+    {
+        // Nothing here
+    }
+
+    int64 WideBVStore::Intern(const WideBVLimbs& Limbs)
+    {
+        auto it = Handles.find(Limbs);
+        if (it != Handles.end()) {
+            return it->second;
+        }
+        int64 Handle;
+        if (FreeHandles.size() > 0) {
+            Handle = FreeHandles.back();
+            FreeHandles.pop_back();
+            Values[Handle] = Limbs;
+        } else {
+            Handle = Values.size();
+            Values.push_back(Limbs);
+        }
+        Handles[Limbs] = Handle;
+        return Handle;
+    }
+
+    const WideBVLimbs& WideBVStore::Get(int64 Handle) const
+    {
+        return Values[Handle];
+    }
+
+    uint64 WideBVStore::GetNumValues() const
+    {
+        return Handles.size();
+    }
+
+    void WideBVStore::Retain(const vector<int64>& Kept)
+    {
+        vector<bool> IsKept(Values.size(), false);
+        int64 LastHandle = -1;
+        for (auto Handle : Kept) {
+            IsKept[Handle] = true;
+            LastHandle = max(LastHandle, Handle);
+        }
+
+        // Rebuild the map from scratch, so that its
+        // buckets shrink along with the values
+        unordered_map<WideBVLimbs, int64, boost::hash<WideBVLimbs>> NewHandles;
+        Values.resize(LastHandle + 1);
+        Values.shrink_to_fit();
+        FreeHandles.clear();
+        for (int64 i = LastHandle; i >= 0; --i) {
+            if (IsKept[i]) {
+                NewHandles[Values[i]] = i;
+            } else {
+                WideBVLimbs().swap(Values[i]);
+                FreeHandles.push_back(i);
+            }
+        }
+        Handles.swap(NewHandles);
+    }
+
+    void WideBVStore::GetMemoryBreakdown(MemoryBreakdown& Breakdown) const
+    {
+        uint64 LimbBytes = 0;
+        for (auto const& Limbs : Values) {
+            LimbBytes += Limbs.capacity() * sizeof(uint64);
+        }
+        Breakdown.Add("WideBVStore.NumValues", Handles.size());
+        Breakdown.Add("WideBVStore.NumFreeHandles", FreeHandles.size());
+        Breakdown.Add("WideBVStore.ValueBytes",
+                      Values.capacity() * sizeof(WideBVLimbs) + LimbBytes +
+                      FreeHandles.capacity() * sizeof(int64));
+        // The map holds a second copy of the limbs
+        Breakdown.Add("WideBVStore.MapBytes",
+                      Handles.bucket_count() * sizeof(void*) +
+                      Handles.size() * (sizeof(pair<WideBVLimbs, int64>) + sizeof(void*)) +
+                      LimbBytes);
+    }
+
+    namespace WideBV {
+
+        // Limb i of A, zero beyond the end
+        static inline uint64 LimbAt(const WideBVLimbs& A, int64 i)
+        {
+            if (i < 0 || i >= (int64)A.size()) {
+                return 0;
+            }
+            return A[i];
+        }
+
+        // Full 128 bit product of two limbs
+        static inline void MulLimbs(uint64 A, uint64 B, uint64& High, uint64& Low)
+        {
+            const uint64 ALo = A & 0xFFFFFFFF, AHi = A >> 32;
+            const uint64 BLo = B & 0xFFFFFFFF, BHi = B >> 32;
+            const uint64 LoLo = ALo * BLo;
+            const uint64 HiLo = AHi * BLo;
+            const uint64 LoHi = ALo * BHi;
+            const uint64 HiHi = AHi * BHi;
+            const uint64 Cross = (LoLo >> 32) + (HiLo & 0xFFFFFFFF) + LoHi;
+            Low = (Cross << 32) | (LoLo & 0xFFFFFFFF);
+            High = HiHi + (HiLo >> 32) + (Cross >> 32);
+        }
+
+        static inline WideBVLimbs ShiftLeft(const WideBVLimbs& A, uint32 Amount, uint32 NumBits)
+        {
+            WideBVLimbs Retval(NumLimbs(NumBits), 0);
+            const int64 LimbShift = Amount / 64;
+            const uint32 BitShift = Amount % 64;
+            for (int64 i = 0; i < (int64)Retval.size(); ++i) {
+                Retval[i] = LimbAt(A, i - LimbShift) << BitShift;
+                if (BitShift != 0) {
+                    Retval[i] |= LimbAt(A, i - LimbShift - 1) >> (64 - BitShift);
+                }
+            }
+            Truncate(Retval, NumBits);
+            return Retval;
+        }
+
+        // Shifts right, filling the vacated bits with Fill (all zeros or all ones)
+        static inline WideBVLimbs ShiftRight(const WideBVLimbs& A, uint32 Amount,
+                                             uint32 NumBits, uint64 Fill)
+        {
+            // Materialize the fill above the width first
+            WideBVLimbs Extended = A;
+            Extended.resize(NumLimbs(NumBits), 0);
+            if (Fill != 0 && NumBits % 64 != 0) {
+                Extended.back() |= ~(((uint64)1 << (NumBits % 64)) - 1);
+            }
+
+            WideBVLimbs Retval(NumLimbs(NumBits), 0);
+            const int64 LimbShift = Amount / 64;
+            const uint32 BitShift = Amount % 64;
+            const int64 Size = Extended.size();
+            for (int64 i = 0; i < Size; ++i) {
+                uint64 Lo = (i + LimbShift < Size ? Extended[i + LimbShift] : Fill);
+                uint64 Hi = (i + LimbShift + 1 < Size ? Extended[i + LimbShift + 1] : Fill);
+                Retval[i] = Lo >> BitShift;
+                if (BitShift != 0) {
+                    Retval[i] |= Hi << (64 - BitShift);
+                }
+            }
+            Truncate(Retval, NumBits);
+            return Retval;
+        }
+
+        // Shift amount as a single word, or NumBits if it is at least that
+        static inline uint32 ShiftAmount(const WideBVLimbs& Amount, uint32 NumBits)
+        {
+            for (uint32 i = 1; i < Amount.size(); ++i) {
+                if (Amount[i] != 0) {
+                    return NumBits;
+                }
+            }
+            const uint64 Shift = LimbAt(Amount, 0);
+            return (Shift >= NumBits ? NumBits : (uint32)Shift);
+        }
+
+        void Truncate(WideBVLimbs& Limbs, uint32 NumBits)
+        {
+            Limbs.resize(NumLimbs(NumBits), 0);
+            if (NumBits % 64 != 0) {
+                Limbs.back() &= (((uint64)1 << (NumBits % 64)) - 1);
+            }
+        }
+
+        WideBVLimbs FromWord(uint64 Value, uint32 NumBits)
+        {
+            WideBVLimbs Retval(1, Value);
+            Truncate(Retval, NumBits);
+            return Retval;
+        }
+
+        bool IsZero(const WideBVLimbs& A)
+        {
+            for (auto Limb : A) {
+                if (Limb != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool IsNegative(const WideBVLimbs& A, uint32 NumBits)
+        {
+            return (((LimbAt(A, (NumBits - 1) / 64) >> ((NumBits - 1) % 64)) & 1) != 0);
+        }
+
+        WideBVLimbs Add(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits)
+        {
+            WideBVLimbs Retval(NumLimbs(NumBits), 0);
+            uint64 Carry = 0;
+            for (uint32 i = 0; i < Retval.size(); ++i) {
+                uint64 Sum = LimbAt(A, i) + Carry;
+                Carry = (Sum < Carry ? 1 : 0);
+                Sum += LimbAt(B, i);
+                Carry += (Sum < LimbAt(B, i) ? 1 : 0);
+                Retval[i] = Sum;
+            }
+            Truncate(Retval, NumBits);
+            return Retval;
+        }
+
+        WideBVLimbs Sub(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits)
+        {
+            WideBVLimbs Retval(NumLimbs(NumBits), 0);
+            uint64 Borrow = 0;
+            for (uint32 i = 0; i < Retval.size(); ++i) {
+                const uint64 AI = LimbAt(A, i), BI = LimbAt(B, i);
+                const uint64 Diff = AI - BI - Borrow;
+                Borrow = ((AI < BI || (AI == BI && Borrow != 0)) ? 1 : 0);
+                Retval[i] = Diff;
+            }
+            Truncate(Retval, NumBits);
+            return Retval;
+        }
+
+        WideBVLimbs Neg(const WideBVLimbs& A, uint32 NumBits)
+        {
+            return Sub(WideBVLimbs(), A, NumBits);
+        }
+
+        WideBVLimbs Mul(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits)
+        {
+            const uint32 Size = NumLimbs(NumBits);
+            WideBVLimbs Retval(Size, 0);
+            // Schoolbook, dropping everything above the width
+            for (uint32 i = 0; i < Size; ++i) {
+                const uint64 AI = LimbAt(A, i);
+                if (AI == 0) {
+                    continue;
+                }
+                uint64 Carry = 0;
+                for (uint32 j = 0; i + j < Size; ++j) {
+                    uint64 High, Low;
+                    MulLimbs(AI, LimbAt(B, j), High, Low);
+                    Low += Carry;
+                    High += (Low < Carry ? 1 : 0);
+                    Retval[i + j] += Low;
+                    High += (Retval[i + j] < Low ? 1 : 0);
+                    Carry = High;
+                }
+            }
+            Truncate(Retval, NumBits);
+            return Retval;
+        }
+
+        void DivRem(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits,
+                    WideBVLimbs& Quotient, WideBVLimbs& Remainder)
+        {
+            // Bit at a time long division. The partial remainder
+            // is kept one bit wider than the operands
+            const uint32 RemBits = NumBits + 1;
+            Quotient.assign(NumLimbs(NumBits), 0);
+            Remainder.assign(NumLimbs(RemBits), 0);
+            for (int64 Bit = NumBits - 1; Bit >= 0; --Bit) {
+                Remainder = ShiftLeft(Remainder, 1, RemBits);
+                Remainder[0] |= (LimbAt(A, Bit / 64) >> (Bit % 64)) & 1;
+                if (UCompare(Remainder, B) >= 0) {
+                    Remainder = Sub(Remainder, B, RemBits);
+                    Quotient[Bit / 64] |= ((uint64)1 << (Bit % 64));
+                }
+            }
+            Truncate(Remainder, NumBits);
+        }
+
+        WideBVLimbs And(const WideBVLimbs& A, const WideBVLimbs& B)
+        {
+            WideBVLimbs Retval(max(A.size(), B.size()));
+            for (uint32 i = 0; i < Retval.size(); ++i) {
+                Retval[i] = LimbAt(A, i) & LimbAt(B, i);
+            }
+            return Retval;
+        }
+
+        WideBVLimbs Or(const WideBVLimbs& A, const WideBVLimbs& B)
+        {
+            WideBVLimbs Retval(max(A.size(), B.size()));
+            for (uint32 i = 0; i < Retval.size(); ++i) {
+                Retval[i] = LimbAt(A, i) | LimbAt(B, i);
+            }
+            return Retval;
+        }
+
+        WideBVLimbs Xor(const WideBVLimbs& A, const WideBVLimbs& B)
+        {
+            WideBVLimbs Retval(max(A.size(), B.size()));
+            for (uint32 i = 0; i < Retval.size(); ++i) {
+                Retval[i] = LimbAt(A, i) ^ LimbAt(B, i);
+            }
+            return Retval;
+        }
+
+        WideBVLimbs Not(const WideBVLimbs& A, uint32 NumBits)
+        {
+            WideBVLimbs Retval(NumLimbs(NumBits));
+            for (uint32 i = 0; i < Retval.size(); ++i) {
+                Retval[i] = ~LimbAt(A, i);
+            }
+            Truncate(Retval, NumBits);
+            return Retval;
+        }
+
+        WideBVLimbs Shl(const WideBVLimbs& A, const WideBVLimbs& Amount, uint32 NumBits)
+        {
+            auto Shift = ShiftAmount(Amount, NumBits);
+            if (Shift >= NumBits) {
+                return WideBVLimbs(NumLimbs(NumBits), 0);
+            }
+            return ShiftLeft(A, Shift, NumBits);
+        }
+
+        WideBVLimbs LShr(const WideBVLimbs& A, const WideBVLimbs& Amount, uint32 NumBits)
+        {
+            auto Shift = ShiftAmount(Amount, NumBits);
+            if (Shift >= NumBits) {
+                return WideBVLimbs(NumLimbs(NumBits), 0);
+            }
+            return ShiftRight(A, Shift, NumBits, 0);
+        }
+
+        WideBVLimbs AShr(const WideBVLimbs& A, const WideBVLimbs& Amount, uint32 NumBits)
+        {
+            auto Shift = ShiftAmount(Amount, NumBits);
+            const uint64 Fill = (IsNegative(A, NumBits) ? ~(uint64)0 : 0);
+            if (Shift >= NumBits) {
+                WideBVLimbs Retval(NumLimbs(NumBits), Fill);
+                Truncate(Retval, NumBits);
+                return Retval;
+            }
+            return ShiftRight(A, Shift, NumBits, Fill);
+        }
+
+        int32 UCompare(const WideBVLimbs& A, const WideBVLimbs& B)
+        {
+            for (int64 i = (int64)max(A.size(), B.size()) - 1; i >= 0; --i) {
+                const uint64 AI = LimbAt(A, i), BI = LimbAt(B, i);
+                if (AI != BI) {
+                    return (AI < BI ? -1 : 1);
+                }
+            }
+            return 0;
+        }
+
+        int32 SCompare(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits)
+        {
+            const bool ANeg = IsNegative(A, NumBits);
+            const bool BNeg = IsNegative(B, NumBits);
+            if (ANeg != BNeg) {
+                return (ANeg ? -1 : 1);
+            }
+            return UCompare(A, B);
+        }
+
+        WideBVLimbs Concat(const WideBVLimbs& High, uint32 HighBits,
+                           const WideBVLimbs& Low, uint32 LowBits)
+        {
+            const uint32 NumBits = HighBits + LowBits;
+            WideBVLimbs LowPart = Low;
+            Truncate(LowPart, LowBits);
+            return Or(ShiftLeft(High, LowBits, NumBits), LowPart);
+        }
+
+        WideBVLimbs Extract(const WideBVLimbs& A, uint32 High, uint32 Low)
+        {
+            auto Retval = ShiftRight(A, Low, max((uint32)A.size() * 64, High + 1), 0);
+            Truncate(Retval, High - Low + 1);
+            return Retval;
+        }
+
+        WideBVLimbs Parse(const string& ValueString, uint32 NumBits)
+        {
+            string ValString = ValueString;
+            // trim
+            ValString.erase(0, ValString.find_first_not_of(" \t\n\r"));
+            ValString.erase(ValString.find_last_not_of(" \t\n\r") + 1);
+
+            if (ValString.length() < 2 || (ValString[0] != '#' && ValString[0] != '0')) {
+                throw ValueException("Malformed Bitvector literal");
+            }
+
+            WideBVLimbs Retval(NumLimbs(NumBits), 0);
+            const char Radix = tolower(ValString[1]);
+            uint32 BitsPerDigit;
+            if (Radix == 'x') {
+                BitsPerDigit = 4;
+            } else if (Radix == 'b') {
+                BitsPerDigit = 1;
+            } else {
+                throw ValueException("Malformed Bitvector literal");
+            }
+
+            const uint32 NumDigits = ValString.length() - 2;
+            if (NumDigits * BitsPerDigit != NumBits) {
+                throw ValueException((string)"Value \"" + ValString + "\" is not a " +
+                                     to_string(NumBits) + " bit bitvector value");
+            }
+
+            // Walk the digits from the least significant end
+            for (uint32 i = 0; i < NumDigits; ++i) {
+                const char Digit = tolower(ValString[ValString.length() - 1 - i]);
+                uint64 DigitValue;
+                if (Digit >= '0' && Digit <= '9') {
+                    DigitValue = Digit - '0';
+                } else if (Digit >= 'a' && Digit <= 'f') {
+                    DigitValue = Digit - 'a' + 10;
+                } else {
+                    DigitValue = 16;
+                }
+                if (DigitValue >= ((uint64)1 << BitsPerDigit)) {
+                    throw ValueException((string)"Value \"" + ValString + "\" is not a valid value");
+                }
+                const uint32 Bit = i * BitsPerDigit;
+                Retval[Bit / 64] |= (DigitValue << (Bit % 64));
+            }
+            Truncate(Retval, NumBits);
+            return Retval;
+        }
+
+        string ToString(const WideBVLimbs& A, uint32 NumBits)
+        {
+            ostringstream sstr;
+            if (NumBits % 4 == 0) {
+                sstr << "#x";
+                for (int64 Digit = NumBits / 4 - 1; Digit >= 0; --Digit) {
+                    const uint32 Bit = Digit * 4;
+                    sstr << "0123456789abcdef"[(LimbAt(A, Bit / 64) >> (Bit % 64)) & 0xF];
+                }
+            } else {
+                sstr << "#b";
+                for (int64 Bit = NumBits - 1; Bit >= 0; --Bit) {
+                    sstr << (((LimbAt(A, Bit / 64) >> (Bit % 64)) & 1) != 0 ? "1" : "0");
+                }
+            }
+            return sstr.str();
+        }
+
+        string ToDecimalString(const WideBVLimbs& A)
+        {
+            // Divide by 10^9 repeatedly, on 32 bit digits so that
+            // the partial dividends fit into a word
+            vector<uint64> Digits;
+            for (int64 i = (int64)A.size() - 1; i >= 0; --i) {
+                Digits.push_back(A[i] >> 32);
+                Digits.push_back(A[i] & 0xFFFFFFFF);
+            }
+
+            const uint64 Base = 1000000000;
+            vector<uint32> Chunks;
+            bool AllZero = false;
+            while (!AllZero) {
+                uint64 Rem = 0;
+                AllZero = true;
+                for (auto& Digit : Digits) {
+                    const uint64 Cur = (Rem << 32) | Digit;
+                    Digit = Cur / Base;
+                    Rem = Cur % Base;
+                    AllZero = AllZero && (Digit == 0);
+                }
+                Chunks.push_back((uint32)Rem);
+            }
+
+            ostringstream sstr;
+            sstr << Chunks.back();
+            for (int64 i = (int64)Chunks.size() - 2; i >= 0; --i) {
+                sstr << setw(9) << setfill('0') << Chunks[i];
+            }
+            return sstr.str();
+        }
+
+    } /* end namespace WideBV */
+
+} /* End namespace */
+
+//
+// WideBitVector.cpp ends here
@@ -0,0 +1,106 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Values and kernels for bitvectors wider than 64 bits
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "../common/ESolverForwardDecls.hpp"
+#include <boost/functional/hash.hpp>
+
+namespace ESolver {
+
+    // A ConcreteValueBase only has room for a single word. Values of
+    // bitvectors wider than 64 bits are interned here and the value
+    // object holds the handle instead. Equal values get equal handles,
+    // so value identity works the same as for all other types. Every
+    // result computed by a wide functor is interned, so each solver
+    // owns a store, which its wide bitvector types point to, and the
+    // values computed during an enumeration are dropped by Retain()
+    // when the enumeration restarts
+    class WideBVStore
+    {
+    private:
+        vector<WideBVLimbs> Values;
+        unordered_map<WideBVLimbs, int64, boost::hash<WideBVLimbs>> Handles;
+        // Handles of dropped values, reused for new ones
+        vector<int64> FreeHandles;
+
+    public:
+        WideBVStore();
+        ~WideBVStore();
+
+        int64 Intern(const WideBVLimbs& Limbs);
+        const WideBVLimbs& Get(int64 Handle) const;
+        uint64 GetNumValues() const;
+
+        // Drops all values but those of the given handles, which
+        // keep their handles. Other handles are invalid afterwards
+        void Retain(const vector<int64>& Kept);
+
+        void GetMemoryBreakdown(MemoryBreakdown& Breakdown) const;
+    };
+
+    namespace WideBV {
+
+        static inline bool IsWide(uint32 NumBits)
+        {
+            return (NumBits > 64);
+        }
+
+        static inline uint32 NumLimbs(uint32 NumBits)
+        {
+            return (NumBits + 63) / 64;
+        }
+
+        // All kernels keep the bits above the width zero.
+        // Clears the bits above NumBits, resizing the limbs as needed
+        void Truncate(WideBVLimbs& Limbs, uint32 NumBits);
+        WideBVLimbs FromWord(uint64 Value, uint32 NumBits);
+        bool IsZero(const WideBVLimbs& A);
+        bool IsNegative(const WideBVLimbs& A, uint32 NumBits);
+
+        WideBVLimbs Add(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits);
+        WideBVLimbs Sub(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits);
+        WideBVLimbs Neg(const WideBVLimbs& A, uint32 NumBits);
+        WideBVLimbs Mul(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits);
+        // Unsigned division, B must be nonzero
+        void DivRem(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits,
+                    WideBVLimbs& Quotient, WideBVLimbs& Remainder);
+
+        WideBVLimbs And(const WideBVLimbs& A, const WideBVLimbs& B);
+        WideBVLimbs Or(const WideBVLimbs& A, const WideBVLimbs& B);
+        WideBVLimbs Xor(const WideBVLimbs& A, const WideBVLimbs& B);
+        WideBVLimbs Not(const WideBVLimbs& A, uint32 NumBits);
+
+        // Shift amounts are bitvectors of the same width, read unsigned
+        WideBVLimbs Shl(const WideBVLimbs& A, const WideBVLimbs& Amount, uint32 NumBits);
+        WideBVLimbs LShr(const WideBVLimbs& A, const WideBVLimbs& Amount, uint32 NumBits);
+        WideBVLimbs AShr(const WideBVLimbs& A, const WideBVLimbs& Amount, uint32 NumBits);
+
+        // Returns < 0, 0 or > 0
+        int32 UCompare(const WideBVLimbs& A, const WideBVLimbs& B);
+        int32 SCompare(const WideBVLimbs& A, const WideBVLimbs& B, uint32 NumBits);
+
+        // High occupies the top HighBits bits of the result
+        WideBVLimbs Concat(const WideBVLimbs& High, uint32 HighBits,
+                           const WideBVLimbs& Low, uint32 LowBits);
+        // Bits High down to Low, both inclusive
+        WideBVLimbs Extract(const WideBVLimbs& A, uint32 High, uint32 Low);
+
+        // Accepts #x, 0x, #b and 0b literals of exactly NumBits bits
+        WideBVLimbs Parse(const string& ValueString, uint32 NumBits);
+        // #x literal if NumBits is a multiple of four, #b literal otherwise
+        string ToString(const WideBVLimbs& A, uint32 NumBits);
+        string ToDecimalString(const WideBVLimbs& A);
+
+    } /* end namespace WideBV */
+
+} /* End namespace */
+
+//
+// WideBitVector.hpp ends here
@@ -0,0 +1,258 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Implementation of SolutionSimplifier
+//===----------------------------------------------------------------------===//
+
+#include "SolutionSimplifier.hpp"
+#include "../solvers/ESolver.hpp"
+#include "../descriptions/Operators.hpp"
+#include "../descriptions/ESType.hpp"
+#include "../descriptions/FunctorBase.hpp"
+#include "../values/ConcreteValueBase.hpp"
+#include "../z3interface/TheoremProver.hpp"
+
+namespace ESolver {
+
+    SolutionSimplifier::SolutionSimplifier(ESolver* Solver,
+                                           const vector<vector<const ConcreteValueBase*>>* Valuations)
+        : ExpressionVisitorBase("SolutionSimplifier"), Solver(Solver),
+          Valuations(Valuations), FoundLet(false)
+    {
+        // Nothing here
+    }
+
+    SolutionSimplifier::~SolutionSimplifier()
+    {
+        // Nothing here
+    }
+
+    inline bool SolutionSimplifier::EvaluateCondition(const Expression& Cond, int64& Value) const
+    {
+        auto ConstExp = UserExpressionBase::As<UserConstExpression>(Cond.GetPtr());
+        if (ConstExp != nullptr) {
+            Value = ConstExp->GetOp()->GetConstantValue()->GetValue();
+            return true;
+        }
+        if (Valuations == nullptr || Valuations->size() == 0) {
+            return false;
+        }
+
+        ConcreteValueBase Result;
+        bool First = true;
+        for (auto const& Valuation : *Valuations) {
+            Cond->Evaluate(nullptr, Valuation.data(), &Result);
+            if (ConcreteException || ConcreteOverflow) {
+                ConcreteException = ConcreteOverflow = false;
+                return false;
+            }
+            if (First) {
+                Value = Result.GetValue();
+                First = false;
+            } else if (Result.GetValue() != Value) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline Expression SolutionSimplifier::Simplify(const Expression& Exp) const
+    {
+        auto const& Children = Exp->GetChildren();
+
+        bool AllConst = true;
+        for (auto const& Child : Children) {
+            if (UserExpressionBase::As<UserConstExpression>(Child.GetPtr()) == nullptr) {
+                AllConst = false;
+                break;
+            }
+        }
+
+        if (AllConst) {
+            ConcreteValueBase Result;
+            Exp->Evaluate(nullptr, nullptr, &Result);
+            if (ConcreteException || ConcreteOverflow) {
+                ConcreteException = ConcreteOverflow = false;
+                return Exp;
+            }
+            return Solver->CreateExpression(Solver->CreateValue(Result.GetType(),
+                                                                Result.GetValue()));
+        }
+
+        auto Op = dynamic_cast<const InterpretedFuncOperator*>(Exp->GetOp());
+        if (Op == nullptr || Children.size() != 3) {
+            return Exp;
+        }
+
+        // When both branches are the same, any value of the
+        // condition tells which argument is returned
+        int64 CondValue = 0;
+        uint32 Branch;
+        bool SameBranches = (Children[1].GetPtr() == Children[2].GetPtr());
+        if ((SameBranches || EvaluateCondition(Children[0], CondValue)) &&
+            GetTakenBranch(Exp, Op, CondValue, Branch)) {
+            return Children[Branch];
+        }
+        return Exp;
+    }
+
+    // Finds the argument out of the last two which the ternary
+    // operator of Exp returns when its first argument is CondValue.
+    // Lazy operators, such as ite, tell this when short circuited.
+    // Other operators, such as the "if0" macro that PBE decision
+    // trees branch with, can only be observed on the valuations,
+    // which is only sound when the rewrite is checked afterwards
+    inline bool SolutionSimplifier::GetTakenBranch(const Expression& Exp,
+                                                   const InterpretedFuncOperator* Op,
+                                                   int64 CondValue, uint32& Branch) const
+    {
+        auto const& Children = Exp->GetChildren();
+        auto Functor = Op->GetConcFunctor();
+        if (Functor->IsLazy()) {
+            ConcreteValueBase CondVal(Children[0]->GetType(), CondValue);
+            ConcreteValueBase Result;
+            Branch = Functor->ShortCircuit(0, &CondVal, &Result);
+            if (Branch == 1 || Branch == 2) {
+                return true;
+            }
+        }
+
+        if (Valuations == nullptr || Valuations->size() == 0) {
+            return false;
+        }
+        bool ThenAgrees = true;
+        bool ElseAgrees = true;
+        ConcreteValueBase Result, ThenResult, ElseResult;
+        for (auto const& Valuation : *Valuations) {
+            Exp->Evaluate(nullptr, Valuation.data(), &Result);
+            if (ConcreteException || ConcreteOverflow) {
+                ConcreteException = ConcreteOverflow = false;
+                return false;
+            }
+            if (ThenAgrees) {
+                Children[1]->Evaluate(nullptr, Valuation.data(), &ThenResult);
+                ThenAgrees = (!ConcreteException && !ConcreteOverflow &&
+                              ThenResult.Equals(Result));
+                ConcreteException = ConcreteOverflow = false;
+            }
+            if (ElseAgrees) {
+                Children[2]->Evaluate(nullptr, Valuation.data(), &ElseResult);
+                ElseAgrees = (!ConcreteException && !ConcreteOverflow &&
+                              ElseResult.Equals(Result));
+                ConcreteException = ConcreteOverflow = false;
+            }
+            if (!ThenAgrees && !ElseAgrees) {
+                return false;
+            }
+        }
+        Branch = (ThenAgrees ? 1 : 2);
+        return true;
+    }
+
+    void SolutionSimplifier::VisitUserUQVarExpression(const UserUQVarExpression* Exp)
+    {
+        RewriteStack.push_back(Expression(Exp));
+    }
+
+    void SolutionSimplifier::VisitUserLetBoundVarExpression(const UserLetBoundVarExpression* Exp)
+    {
+        RewriteStack.push_back(Expression(Exp));
+    }
+
+    void SolutionSimplifier::VisitUserFormalParamExpression(const UserFormalParamExpression* Exp)
+    {
+        Params[Exp->GetOp()->GetPosition()] = Exp->GetOp();
+        RewriteStack.push_back(Expression(Exp));
+    }
+
+    void SolutionSimplifier::VisitUserAuxVarExpression(const UserAuxVarExpression* Exp)
+    {
+        RewriteStack.push_back(Expression(Exp));
+    }
+
+    void SolutionSimplifier::VisitUserConstExpression(const UserConstExpression* Exp)
+    {
+        RewriteStack.push_back(Expression(Exp));
+    }
+
+    void SolutionSimplifier::VisitUserInterpretedFuncExpression(const UserInterpretedFuncExpression* Exp)
+    {
+        // Recurse on the children first
+        auto const& Children = Exp->GetChildren();
+        for (auto const& Child : Children) {
+            Child->Accept(this);
+        }
+
+        auto const NumChildren = Children.size();
+        vector<Expression> NewChildren(NumChildren);
+        for (uint32 i = 0; i < NumChildren; ++i) {
+            NewChildren[NumChildren - i - 1] = RewriteStack.back();
+            RewriteStack.pop_back();
+        }
+
+        auto NewExp = Solver->CreateExpression(Exp->GetOp(), NewChildren);
+        RewriteStack.push_back(Simplify(NewExp));
+    }
+
+    void SolutionSimplifier::VisitUserSynthFuncExpression(const UserSynthFuncExpression* Exp)
+    {
+        RewriteStack.push_back(Expression(Exp));
+    }
+
+    void SolutionSimplifier::VisitUserLetExpression(const UserLetExpression* Exp)
+    {
+        // Let bound variables cannot be evaluated on their own,
+        // leave let expressions as they are
+        FoundLet = true;
+        RewriteStack.push_back(Expression(Exp));
+    }
+
+    Expression SolutionSimplifier::Do(ESolver* Solver, const Expression& Exp,
+                                      const vector<vector<const ConcreteValueBase*>>& Valuations,
+                                      TheoremProver* TP)
+    {
+        SolutionSimplifier Simplifier(Solver, nullptr);
+        Exp->Accept(&Simplifier);
+        auto Retval = Simplifier.RewriteStack.back();
+
+        if (TP == nullptr || Valuations.size() == 0 || Simplifier.FoundLet) {
+            return Retval;
+        }
+
+        SolutionSimplifier Pruner(Solver, &Valuations);
+        Retval->Accept(&Pruner);
+        auto Pruned = Pruner.RewriteStack.back();
+        if (Pruned.GetPtr() == Retval.GetPtr()) {
+            return Retval;
+        }
+
+        // The pruned branches were only never taken on the
+        // valuations, check that nothing else changed
+        uint32 NumParams = 0;
+        if (Simplifier.Params.size() > 0) {
+            NumParams = Simplifier.Params.rbegin()->first + 1;
+        }
+        vector<SMTExpr> ParamExprs(NumParams);
+        for (auto const& PosOp : Simplifier.Params) {
+            ParamExprs[PosOp.first] = TP->CreateVarExpr(PosOp.second->GetName(),
+                                                        PosOp.second->GetEvalType()->GetSMTType());
+        }
+
+        vector<SMTExpr> Assumptions;
+        auto RetvalSMT = Retval->ToSMT(TP, nullptr, ParamExprs, Assumptions);
+        auto PrunedSMT = Pruned->ToSMT(TP, nullptr, ParamExprs, Assumptions);
+        auto Query = TP->CreateImpliesExpr(TP->CreateAndExpr(Assumptions),
+                                           TP->CreateEQExpr(RetvalSMT, PrunedSMT));
+        if (TP->CheckValidity(Query) == SOLVE_VALID) {
+            return Pruned;
+        }
+        return Retval;
+    }
+
+} /* End namespace */
+
+//
+// SolutionSimplifier.cpp ends here
@@ -0,0 +1,63 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// This file is distributed under BSD License. See LICENSE.txt for details.
+//
+//===----------------------------------------------------------------------===//
+// \file
+// Simplifies a synthesized solution before it is handed out
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "../visitors/ExpressionVisitorBase.hpp"
+#include "../expressions/UserExpression.hpp"
+#include "../containers/ESSmartPtr.hpp"
+
+namespace ESolver {
+
+    // Rewrites a solution bottom up:
+    // - applications to constants are folded into a constant
+    // - ite's with identical branches or a constant condition are collapsed
+    // When parameter valuations are given, branches whose condition
+    // evaluates the same on all of them are pruned as well. That is only
+    // sound modulo the valuations, so Do() confirms such rewrites with the
+    // theorem prover before accepting them.
+    class SolutionSimplifier : public ExpressionVisitorBase
+    {
+    private:
+        ESolver* Solver;
+        const vector<vector<const ConcreteValueBase*>>* Valuations;
+        vector<Expression> RewriteStack;
+        map<uint32, const FormalParamOperator*> Params;
+        bool FoundLet;
+
+        inline bool EvaluateCondition(const Expression& Cond, int64& Value) const;
+        inline bool GetTakenBranch(const Expression& Exp, const InterpretedFuncOperator* Op,
+                                   int64 CondValue, uint32& Branch) const;
+        inline Expression Simplify(const Expression& Exp) const;
+
+    public:
+        SolutionSimplifier(ESolver* Solver,
+                           const vector<vector<const ConcreteValueBase*>>* Valuations);
+        virtual ~SolutionSimplifier();
+
+        virtual void VisitUserUQVarExpression(const UserUQVarExpression* Exp) override;
+        virtual void VisitUserLetBoundVarExpression(const UserLetBoundVarExpression* Exp) override;
+        virtual void VisitUserFormalParamExpression(const UserFormalParamExpression* Exp) override;
+        virtual void VisitUserAuxVarExpression(const UserAuxVarExpression* Exp) override;
+        virtual void VisitUserConstExpression(const UserConstExpression* Exp) override;
+        virtual void VisitUserInterpretedFuncExpression(const UserInterpretedFuncExpression* Exp) override;
+        virtual void VisitUserSynthFuncExpression(const UserSynthFuncExpression* Exp) override;
+        virtual void VisitUserLetExpression(const UserLetExpression* Exp) override;
+
+        // TP may be null, in which case only the rewrites that
+        // hold regardless of the valuations are applied
+        static Expression Do(ESolver* Solver, const Expression& Exp,
+                             const vector<vector<const ConcreteValueBase*>>& Valuations,
+                             TheoremProver* TP);
+    };
+
+} /* End namespace */
+
+//
+// SolutionSimplifier.hpp ends here
@@ -94,7 +94,7 @@ namespace ESolver {
         // Gather the child expressions first
         vector<Expression> SubstChildren(Children.size());
         for (uint32 i = 0; i < NumChildren; ++i) {
-            SubstChildren[Children.size() - i - 1] = RewriteStack.back();
+            SubstChildren[Children.size() - i - 1] = move(RewriteStack.back());
             RewriteStack.pop_back();
         }
 
@@ -167,12 +167,11 @@ namespace ESolver {
         vector<Expression> NewChildren(NumChildren);
 
         for (uint32 i = 0; i < NumChildren; ++i) {
-            NewChildren[NumChildren - i - 1] = RewriteStack.back();
+            NewChildren[NumChildren - i - 1] = move(RewriteStack.back());
             RewriteStack.pop_back();
         }
 
-        auto NewExp = Solver->CreateExpression(Exp->GetOp(), NewChildren);
-        RewriteStack.push_back(NewExp);
+        RewriteStack.push_back(Solver->CreateExpression(Exp->GetOp(), NewChildren));
     }
 
     void SpecRewriter::VisitUserLetExpression(const UserLetExpression* Exp)
@@ -182,7 +181,7 @@ namespace ESolver {
 
         for (auto const& Binding : Bindings) {
             Binding.second->Accept(this);
-            auto RewrittenBinding = RewriteStack.back();
+            auto RewrittenBinding = move(RewriteStack.back());
             RewriteStack.pop_back();
 
             auto Op = Solver->CreateAuxVariable(AuxIDCounter++, RewrittenBinding->GetType());
@@ -76,16 +76,19 @@ namespace ESolver {
         virtual SMTType CreateArrayType(const SMTType& IndexType, const SMTType& ElementType) = 0;
         virtual SMTType CreateIntType() = 0;
         virtual SMTType CreateBoolType() = 0;
+        virtual SMTType CreateStringType() = 0;
 
         // Constant Expression creation methods
         virtual SMTExpr CreateIntConstant(int64 IntValue) = 0;
         virtual SMTExpr CreateIntConstant(const string& IntValue) = 0;
         virtual SMTExpr CreateBVConstant(uint64 BVValue, uint32 BVSize) = 0;
         virtual SMTExpr CreateBVConstant(const string& BVValue) = 0;
+        virtual SMTExpr CreateBVConstant(const WideBVLimbs& BVValue, uint32 BVSize) = 0;
         virtual SMTExpr CreateEnumConstant(const string& EnumValue) = 0;
         virtual SMTExpr CreateRealConstant(int32 Numerator, int32 Denominator) = 0;
         virtual SMTExpr CreateRealConstant(const string& RealValue) = 0;
         virtual SMTExpr CreateRealConstant(double RealValue) = 0;
+        virtual SMTExpr CreateStringConstant(const string& StringValue) = 0;
         
         // Expression creation methods
         // arithmetic, real and core
@@ -164,6 +167,17 @@ namespace ESolver {
 
         // end additions to support Jha's PLDI 2011 benchmarks
 
+        // strings, with the SMT-LIB semantics
+        virtual SMTExpr CreateStrConcatExpr(const SMTExpr& Exp1, const SMTExpr& Exp2) = 0;
+        virtual SMTExpr CreateStrSubstrExpr(const SMTExpr& Exp, const SMTExpr& Offset,
+                                            const SMTExpr& Length) = 0;
+        virtual SMTExpr CreateStrAtExpr(const SMTExpr& Exp, const SMTExpr& Index) = 0;
+        virtual SMTExpr CreateStrIndexOfExpr(const SMTExpr& Exp, const SMTExpr& Pattern,
+                                             const SMTExpr& Offset) = 0;
+        virtual SMTExpr CreateStrReplaceExpr(const SMTExpr& Exp, const SMTExpr& Pattern,
+                                             const SMTExpr& Replacement) = 0;
+        virtual SMTExpr CreateStrLenExpr(const SMTExpr& Exp) = 0;
+
         // Sets and arrays
         virtual SMTExpr CreateEmptySetExpr(const SMTType& ElemType) = 0;
         virtual SMTExpr CreateFullSetExpr(const SMTType& ElemType) = 0;
@@ -215,6 +229,9 @@ namespace ESolver {
 
         // Stringification routine
         virtual string SMTExprToString(const SMTExpr& Exp) = 0;
+
+        // Bytes allocated by the SMT solver
+        virtual uint64 GetEstimatedAllocSize() const = 0;
     };
 
 } /* End namespace */
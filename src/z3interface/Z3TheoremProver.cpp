@@ -44,6 +44,7 @@
 #include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 #include "../descriptions/Operators.hpp"
+#include "../values/WideBitVector.hpp"
 
 namespace ESolver {
 
@@ -84,6 +85,7 @@ namespace ESolver {
 
         BoolType = Z3Sort(TheContext, Z3_mk_bool_sort(TheContext));
         IntType = Z3Sort(TheContext, Z3_mk_int_sort(TheContext));
+        StringType = Z3Sort(TheContext, Z3_mk_string_sort(TheContext));
     }
 
     Z3TheoremProver::~Z3TheoremProver()
@@ -96,6 +98,7 @@ namespace ESolver {
         }
         BoolType = SMTType();
         IntType = SMTType();
+        StringType = SMTType();
         TheModel = Z3Model();
         Z3_solver_dec_ref(TheContext, TheSolver);
         Z3_del_context(TheContext);
@@ -187,6 +190,11 @@ namespace ESolver {
         return BoolType;
     }
 
+    SMTType Z3TheoremProver::CreateStringType()
+    {
+        return StringType;
+    }
+
     SMTExpr Z3TheoremProver::CreateIntConstant(int64 TheValue)
     {
         return Z3Expr(TheContext, Z3_mk_int64(TheContext, TheValue, IntType.Sort));
@@ -217,12 +225,27 @@ namespace ESolver {
         return Retval;
     }
 
+    SMTExpr Z3TheoremProver::CreateBVConstant(const WideBVLimbs& BVValue, uint32 BVSize)
+    {
+        Z3_sort BVSort = Z3_mk_bv_sort(TheContext, BVSize);
+        Z3_inc_ref(TheContext, Z3_sort_to_ast(TheContext, BVSort));
+        SMTExpr Retval = Z3Expr(TheContext, Z3_mk_numeral(TheContext,
+                                                          WideBV::ToDecimalString(BVValue).c_str(),
+                                                          BVSort));
+        Z3_dec_ref(TheContext, Z3_sort_to_ast(TheContext, BVSort));
+        return Retval;
+    }
+
     SMTExpr Z3TheoremProver::CreateBVConstant(const string& BVValue)
     {
         // Convert the bit vector value to a decimal string
         uint64 NumValue = 0;
         const uint32 NumBits = BVValue.length();
 
+        if (WideBV::IsWide(NumBits)) {
+            return CreateBVConstant(WideBV::Parse("#b" + BVValue, NumBits), NumBits);
+        }
+
         for(uint32 i = 0; i < NumBits; ++i) {
             NumValue <<= 1;
             if(BVValue[i] == '0') {
@@ -264,6 +287,11 @@ namespace ESolver {
         return Z3Expr(TheContext, Z3_mk_numeral(TheContext, sstr.str().c_str(), Z3_mk_real_sort(TheContext)));
     }
 
+    SMTExpr Z3TheoremProver::CreateStringConstant(const string& StringValue)
+    {
+        return Z3Expr(TheContext, Z3_mk_lstring(TheContext, StringValue.length(), StringValue.c_str()));
+    }
+
     SMTExpr Z3TheoremProver::CreateVarExpr(const string& VarName, const SMTType& VarType)
     {
         Z3_symbol VarSymbol = Z3_mk_string_symbol(TheContext, VarName.c_str());
@@ -627,6 +655,41 @@ namespace ESolver {
         return Z3Expr(TheContext, Z3_mk_concat(TheContext, Exp1.AST, Exp2.AST));
     }
 
+    SMTExpr Z3TheoremProver::CreateStrConcatExpr(const SMTExpr& Exp1, const SMTExpr& Exp2)
+    {
+        Z3_ast Args[2] = { Exp1.AST, Exp2.AST };
+        return Z3Expr(TheContext, Z3_mk_seq_concat(TheContext, 2, Args));
+    }
+
+    SMTExpr Z3TheoremProver::CreateStrSubstrExpr(const SMTExpr& Exp, const SMTExpr& Offset,
+                                                 const SMTExpr& Length)
+    {
+        return Z3Expr(TheContext, Z3_mk_seq_extract(TheContext, Exp.AST, Offset.AST, Length.AST));
+    }
+
+    SMTExpr Z3TheoremProver::CreateStrAtExpr(const SMTExpr& Exp, const SMTExpr& Index)
+    {
+        return Z3Expr(TheContext, Z3_mk_seq_at(TheContext, Exp.AST, Index.AST));
+    }
+
+    SMTExpr Z3TheoremProver::CreateStrIndexOfExpr(const SMTExpr& Exp, const SMTExpr& Pattern,
+                                                  const SMTExpr& Offset)
+    {
+        return Z3Expr(TheContext, Z3_mk_seq_index(TheContext, Exp.AST, Pattern.AST, Offset.AST));
+    }
+
+    SMTExpr Z3TheoremProver::CreateStrReplaceExpr(const SMTExpr& Exp, const SMTExpr& Pattern,
+                                                  const SMTExpr& Replacement)
+    {
+        return Z3Expr(TheContext, Z3_mk_seq_replace(TheContext, Exp.AST, Pattern.AST,
+                                                    Replacement.AST));
+    }
+
+    SMTExpr Z3TheoremProver::CreateStrLenExpr(const SMTExpr& Exp)
+    {
+        return Z3Expr(TheContext, Z3_mk_seq_length(TheContext, Exp.AST));
+    }
+
     SMTExpr Z3TheoremProver::CreateEmptySetExpr(const SMTType& ElementType)
     {
         return Z3Expr(TheContext, Z3_mk_empty_set(TheContext, ElementType.Sort));
@@ -855,9 +918,19 @@ namespace ESolver {
                 ConcModel[CurVarName] = Solver->CreateValue(Type, ValueString);
                 break;
 
+            case BaseTypeString:
+                ConcModel[CurVarName] = Solver->CreateValue(Type, ValueString);
+                break;
+
             case BaseTypeBitVector:
-                ModelValue = ParseZ3BVString(ValueString, Type);
                 NumBits = Type->As<ESBVType>()->GetSize();
+                if (WideBV::IsWide(NumBits)) {
+                    ConcModel[CurVarName] =
+                        Solver->CreateValue(Type, Type->As<ESBVType>()->GetStore()->Intern(
+                                                      WideBV::Parse(ValueString, NumBits)));
+                    break;
+                }
+                ModelValue = ParseZ3BVString(ValueString, Type);
                 Shift = 64 - NumBits;
                 ModelValue = (ModelValue << Shift) >> Shift;
                 ConcModel[CurVarName] =
@@ -893,6 +966,11 @@ namespace ESolver {
         return "Z3";
     }
 
+    uint64 Z3TheoremProver::GetEstimatedAllocSize() const
+    {
+        return Z3_get_estimated_alloc_size();
+    }
+
     uint64 Z3TheoremProver::GetHash(const SMTExpr& Exp)
     {
         return Exp.Hash();
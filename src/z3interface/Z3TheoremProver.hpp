@@ -60,6 +60,7 @@ namespace ESolver {
         SMTSolverParams TheParams;
         Z3Sort BoolType;
         Z3Sort IntType;
+        Z3Sort StringType;
 
         // Utility function
         SMTExpr GenBVToIntExpr(const SMTExpr& Expr, uint32 BitNum);
@@ -81,16 +82,19 @@ namespace ESolver {
         virtual SMTType CreateArrayType(const SMTType& IndexType, const SMTType& ElementType) override;
         virtual SMTType CreateIntType() override;
         virtual SMTType CreateBoolType() override;
+        virtual SMTType CreateStringType() override;
 
         // Constant Expression creation methods
         virtual SMTExpr CreateIntConstant(int64 IntValue) override;
         virtual SMTExpr CreateIntConstant(const string& IntValue) override;
         virtual SMTExpr CreateBVConstant(uint64 BVValue, uint32 BVSize) override;
         virtual SMTExpr CreateBVConstant(const string& BVValue) override;
+        virtual SMTExpr CreateBVConstant(const WideBVLimbs& BVValue, uint32 BVSize) override;
         virtual SMTExpr CreateEnumConstant(const string& EnumValue) override;
         virtual SMTExpr CreateRealConstant(int32 Numerator, int32 Denominator) override;
         virtual SMTExpr CreateRealConstant(const string& RealValue) override;
         virtual SMTExpr CreateRealConstant(double RealValue) override;
+        virtual SMTExpr CreateStringConstant(const string& StringValue) override;
 
         
         // Expression creation methods
@@ -167,6 +171,17 @@ namespace ESolver {
 
         // end additions to support Jha's PLDI 2011 benchmarks
 
+        // strings, with the SMT-LIB semantics
+        virtual SMTExpr CreateStrConcatExpr(const SMTExpr& Exp1, const SMTExpr& Exp2) override;
+        virtual SMTExpr CreateStrSubstrExpr(const SMTExpr& Exp, const SMTExpr& Offset,
+                                            const SMTExpr& Length) override;
+        virtual SMTExpr CreateStrAtExpr(const SMTExpr& Exp, const SMTExpr& Index) override;
+        virtual SMTExpr CreateStrIndexOfExpr(const SMTExpr& Exp, const SMTExpr& Pattern,
+                                             const SMTExpr& Offset) override;
+        virtual SMTExpr CreateStrReplaceExpr(const SMTExpr& Exp, const SMTExpr& Pattern,
+                                             const SMTExpr& Replacement) override;
+        virtual SMTExpr CreateStrLenExpr(const SMTExpr& Exp) override;
+
         // Sets and arrays
         virtual SMTExpr CreateEmptySetExpr(const SMTType& ElemType) override;
         virtual SMTExpr CreateFullSetExpr(const SMTType& ElemType) override;
@@ -218,6 +233,9 @@ namespace ESolver {
 
         // Stringification routine
         virtual string SMTExprToString(const SMTExpr& Exp) override;
+
+        // Bytes allocated by the SMT solver
+        virtual uint64 GetEstimatedAllocSize() const override;
     };
 
 } /* End namespace */